@@ -0,0 +1,96 @@
+#include "Mesh.h"
+#include <unordered_map>
+#include <functional>
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Append a face
+// @param faceCorners: corners of the face, in winding order
+// @param numCorners: number of corners, 3 or more
+void
+Mesh::addFace(const Vertex* faceCorners, size_t numCorners){
+	corners.append(faceCorners, numCorners);
+	faceOffsets.push_back(corners.size());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Hash of the position/normal/texture index triple of a face corner
+struct VertexHash {
+	size_t operator()(const Vertex& v) const {
+		size_t h = hash<int>()(v.pointIdx);
+		h = h*31 + hash<int>()(v.normalIdx);
+		return h*31 + hash<int>()(v.textureIdx);
+	}
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Equality of face corners
+struct VertexEqual {
+	bool operator()(const Vertex& a, const Vertex& b) const {
+		return a.pointIdx == b.pointIdx && a.normalIdx == b.normalIdx &&
+			a.textureIdx == b.textureIdx;
+	}
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Build the indexed triangle mesh that is drawn. Face corners sharing
+//		   the same position, normal and texture indices become one vertex,
+//		   and polygons are split into a fan of triangles (quad 0123 becomes
+//		   012 and 023), keeping the winding.
+// @return: false if a corner indexes past the attributes of the OBJ
+bool
+Mesh::buildTriangles(){
+	vertices.clear();
+	indices.clear();
+	size_t numTriangles = corners.size() - 2*getNumFaces();
+	indices.reserve(3*numTriangles);
+	unordered_map<Vertex, unsigned int, VertexHash, VertexEqual> vertexIds;
+	vertexIds.reserve(points.size());
+	hasNormals = !corners.empty();
+	hasTexCoords = !corners.empty();
+
+	for(const Vertex& corner : corners){
+		if(corner.pointIdx < 0 || corner.pointIdx >= (int)points.size() ||
+			corner.normalIdx < -1 || corner.normalIdx >= (int)normals.size() ||
+			corner.textureIdx < -1 || corner.textureIdx >= (int)textures.size())
+			return false;
+		hasNormals = hasNormals && corner.normalIdx != -1;
+		hasTexCoords = hasTexCoords && corner.textureIdx != -1;
+	}
+
+	auto addCorner = [&](const Vertex& corner){
+		auto inserted = vertexIds.emplace(corner, (unsigned int)vertices.size());
+		if(inserted.second){
+			MeshVertex vertex;
+			vertex.pos = points[corner.pointIdx];
+			vertex.normal = glm::vec3(0.f);
+			vertex.texCoord = glm::vec2(0.f);
+			if(corner.normalIdx != -1)
+				vertex.normal = normals[corner.normalIdx];
+			if(corner.textureIdx != -1)
+				vertex.texCoord = glm::vec2(textures[corner.textureIdx]);
+			vertices.push_back(vertex);
+		}
+		indices.push_back(inserted.first->second);
+	};
+
+	for(size_t f = 0; f < getNumFaces(); f++){
+		const Vertex* face = getCorners(f);
+		for(size_t i = 2; i < getNumCorners(f); i++){
+			addCorner(face[0]);
+			addCorner(face[i - 1]);
+			addCorner(face[i]);
+		}
+	}
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Bytes of heap held by the arrays of the mesh, not counting arrays
+//		   viewing a mapped cache file
+size_t
+Mesh::getMemoryUsage() const{
+	return points.getMemoryUsage() + normals.getMemoryUsage() +
+		textures.getMemoryUsage() + corners.getMemoryUsage() +
+		faceOffsets.getMemoryUsage() + vertices.getMemoryUsage() +
+		indices.getMemoryUsage();
+}
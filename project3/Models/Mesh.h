@@ -0,0 +1,141 @@
+//////////////////////////////////////////////////////////////////////////////
+// @brief: This struct represents the geometry of a model in flat arrays.
+//		   The OBJ attributes are kept as read, and the faces are stored back
+//		   to back as their corners: face f is corners[faceOffsets[f]] up to
+//		   corners[faceOffsets[f + 1]]. buildTriangles() derives from them the
+//		   deduplicated vertices and the triangle indices that are drawn.
+//		   A mesh loaded from the cache views the arrays of the mapped cache
+//		   file instead of holding copies.
+#ifndef MESH_H
+#define MESH_H
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include "../Utilities/glm/glm.hpp"
+#include "../Utilities/MappedFile.h"
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Struct vertex, one corner of a face. Each vertex contains indices
+//		   (0-based, -1 if absent) of its position, normal and texture
+//		   coordinates.
+struct Vertex {
+	int pointIdx{-1};
+	int normalIdx{-1};
+	int textureIdx{-1};
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Vertex of the drawn mesh, one per distinct position/normal/texture
+//		   index triple of the faces
+struct MeshVertex {
+	glm::vec3 pos;
+	glm::vec3 normal;
+	glm::vec2 texCoord;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Array of a mesh. It either owns its elements, or views elements
+//		   owned elsewhere (a mapped cache file). Resizing or appending to a
+//		   view first copies the elements into the array's own storage;
+//		   elements of a view must not be written in place.
+template <class T>
+class MeshArray {
+public:
+	MeshArray() {}
+	// A copy of an owning array owns a copy of the elements, a copy of a
+	// view views the same elements
+	MeshArray(const MeshArray& other) { *this = other; }
+	MeshArray(MeshArray&& other) { *this = move(other); }
+	MeshArray& operator=(const MeshArray& other) {
+		if(this != &other){
+			owned = other.owned;
+			items = other.isView() ? other.items : owned.data();
+			count = other.count;
+		}
+		return *this;
+	}
+	MeshArray& operator=(MeshArray&& other) {
+		if(this != &other){
+			bool view = other.isView();
+			owned = move(other.owned);
+			items = view ? other.items : owned.data();
+			count = other.count;
+			other.owned.clear();
+			other.update();
+		}
+		return *this;
+	}
+
+	size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+	T* data() { return items; }
+	const T* data() const { return items; }
+	T* begin() { return items; }
+	T* end() { return items + count; }
+	const T* begin() const { return items; }
+	const T* end() const { return items + count; }
+	T& operator[](size_t i) { return items[i]; }
+	const T& operator[](size_t i) const { return items[i]; }
+	T& back() { return items[count - 1]; }
+	// Heap held by the array, 0 for a view
+	size_t getMemoryUsage() const { return owned.capacity()*sizeof(T); }
+
+	void view(const T* first, size_t n) {
+		owned.clear();
+		owned.shrink_to_fit();
+		items = const_cast<T*>(first);
+		count = n;
+	}
+	void clear() { own(); owned.clear(); update(); }
+	void reserve(size_t n) { own(); owned.reserve(n); update(); }
+	void resize(size_t n) { own(); owned.resize(n); update(); }
+	void push_back(const T& item) { own(); owned.push_back(item); update(); }
+	void append(const T* first, size_t n) {
+		own();
+		owned.insert(owned.end(), first, first + n);
+		update();
+	}
+
+private:
+	vector<T> owned;		//< Elements, unless the array is a view
+	T* items{nullptr};		//< First element
+	size_t count{0};		//< Number of elements
+
+	bool isView() const { return items != owned.data(); }
+	void own() {
+		if(isView())
+			owned.assign(items, items + count);
+	}
+	void update() { items = owned.data(); count = owned.size(); }
+};
+
+struct Mesh {
+	MeshArray<glm::vec3> points;	//< Positions of the OBJ
+	MeshArray<glm::vec3> normals;	//< Normals of the OBJ
+	MeshArray<glm::vec3> textures;	//< Texture coordinates of the OBJ
+	MeshArray<Vertex> corners;		//< Corners of all faces, face by face
+	MeshArray<unsigned int> faceOffsets;	//< First corner of each face, plus
+											//< the total number of corners
+	MeshArray<MeshVertex> vertices;	//< Deduplicated vertices of all faces
+	MeshArray<unsigned int> indices;	//< Triangles indexing vertices
+	bool hasNormals{false};			//< Every face corner has a normal
+	bool hasTexCoords{false};		//< Every face corner has a texture
+									//< coordinate
+	shared_ptr<MappedFile> storage;	//< Mapped cache file the arrays view,
+									//< if any
+
+	Mesh() { faceOffsets.push_back(0); }
+
+	size_t getNumFaces() const { return faceOffsets.size() - 1; }
+	size_t getNumCorners(size_t face) const {
+		return faceOffsets[face + 1] - faceOffsets[face]; }
+	const Vertex* getCorners(size_t face) const {
+		return corners.data() + faceOffsets[face]; }
+
+	void addFace(const Vertex* faceCorners, size_t numCorners);
+	bool buildTriangles();
+	size_t getMemoryUsage() const;
+};
+#endif
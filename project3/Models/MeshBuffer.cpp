@@ -0,0 +1,72 @@
+#include "MeshBuffer.h"
+#include <cstddef>
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Constructor, uploads the triangles of the mesh
+// @param mesh: mesh whose vertices and indices are uploaded
+MeshBuffer::MeshBuffer(const Mesh& mesh){
+	const MeshArray<MeshVertex>& vertices = mesh.vertices;
+	const MeshArray<unsigned int>& indices = mesh.indices;
+	numIndices = indices.size();
+	hasNormals = mesh.hasNormals;
+	hasTexCoords = mesh.hasTexCoords;
+
+	glGenBuffers(1, &vertexBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+	glBufferData(GL_ARRAY_BUFFER, vertices.size()*sizeof(MeshVertex),
+		vertices.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glGenBuffers(1, &indexBuffer);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size()*sizeof(unsigned int),
+		indices.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Destructor
+MeshBuffer::~MeshBuffer(){
+	glDeleteBuffers(1, &vertexBuffer);
+	glDeleteBuffers(1, &indexBuffer);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Bind the buffers and point the vertex arrays into them
+void
+MeshBuffer::bind(){
+	glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glVertexPointer(3, GL_FLOAT, sizeof(MeshVertex),
+		(const GLvoid*)offsetof(MeshVertex, pos));
+	if(hasNormals){
+		glEnableClientState(GL_NORMAL_ARRAY);
+		glNormalPointer(GL_FLOAT, sizeof(MeshVertex),
+			(const GLvoid*)offsetof(MeshVertex, normal));
+	}
+	if(hasTexCoords){
+		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+		glTexCoordPointer(2, GL_FLOAT, sizeof(MeshVertex),
+			(const GLvoid*)offsetof(MeshVertex, texCoord));
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Draw the triangles of the bound mesh with the current color,
+//		   material and transform
+void
+MeshBuffer::drawElements(){
+	glDrawElements(GL_TRIANGLES, numIndices, GL_UNSIGNED_INT, nullptr);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Disable the vertex arrays and unbind the buffers
+void
+MeshBuffer::unbind(){
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState(GL_NORMAL_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
@@ -0,0 +1,29 @@
+//////////////////////////////////////////////////////////////////////////////
+// @brief: This class represents a static mesh uploaded to the GPU: one
+//		   vertex buffer of interleaved MeshVertex and one index buffer of
+//		   triangles, drawn with a single glDrawElements. Models sharing the
+//		   mesh are drawn between one bind() and unbind(). Only drawing code
+//		   includes this, a GL context with buffer objects must be current
+//		   for every call (see glHasBufferObjects).
+#ifndef MESHBUFFER_H
+#define MESHBUFFER_H
+#include "Model.h"
+#include "../Utilities/GL.h"
+
+class MeshBuffer {
+public:
+	MeshBuffer(const Mesh& mesh);
+	~MeshBuffer();
+	void bind();
+	void drawElements();
+	void unbind();
+
+private:
+	GLuint vertexBuffer{0};		//< Interleaved MeshVertex
+	GLuint indexBuffer{0};		//< Triangle indices
+	GLsizei numIndices;			//< Number of indices, 3 per triangle
+	bool hasNormals;			//< Whether to enable the normal array
+	bool hasTexCoords;			//< Whether to enable the texture coordinate
+								//< array
+};
+#endif
@@ -0,0 +1,363 @@
+#include "MeshCache.h"
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+bool MeshCache::enabled = true;
+string MeshCache::directory;
+
+// Arrays stored in a cache file, in file order
+enum CacheSection {PathSection, PointSection, NormalSection, TextureSection,
+	CornerSection, FaceOffsetSection, VertexSection, IndexSection,
+	NumCacheSections};
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Start of a cache file. The sections follow, each 16-byte aligned.
+struct MeshCacheHeader {
+	char magic[8];				//< "SPDRMESH"
+	uint32_t version;			//< MESH_CACHE_VERSION
+	uint32_t byteOrder;			//< 0x01020304 in the writer's byte order
+	uint32_t vertexSize;		//< sizeof(MeshVertex) of the writer
+	uint32_t cornerSize;		//< sizeof(Vertex) of the writer
+	uint64_t sourceSize;		//< Size of the OBJ
+	int64_t sourceMtime;		//< Modification time of the OBJ in ns
+	uint64_t sourceHash;		//< MeshCache::hash of the OBJ
+	float centerOfMass[3];		//< Center of mass of the model
+	uint32_t flags;				//< HasNormals | HasTexCoords
+	uint64_t offsets[NumCacheSections];	//< Start of each section
+	uint64_t counts[NumCacheSections];	//< Number of elements of each section
+};
+
+static const char cacheMagic[8] = {'S', 'P', 'D', 'R', 'M', 'E', 'S', 'H'};
+enum CacheFlags {HasNormals = 1, HasTexCoords = 2};
+
+// Size of an element of each section
+static const size_t sectionSizes[NumCacheSections] = {sizeof(char),
+	sizeof(glm::vec3), sizeof(glm::vec3), sizeof(glm::vec3), sizeof(Vertex),
+	sizeof(unsigned int), sizeof(MeshVertex), sizeof(unsigned int)};
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Pointer to a section of a mapped mesh image
+template <class T>
+static const T*
+section(const MeshCacheHeader& header, CacheSection which){
+	return (const T*)((const char*)&header + header.offsets[which]);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Check a mesh image in a mapped file: a header then the sections
+// @param file: mapped file holding the image
+// @param offset: start of the image in the file, 16-byte aligned
+// @param size: size of the image
+// @return: header of the image, or null if the image was not written by this
+//		  version, on this kind of machine, or is damaged
+static const MeshCacheHeader*
+readImage(MappedFile& file, uint64_t offset, uint64_t size){
+	if(offset % 16 != 0 || offset > file.size() || size > file.size() - offset ||
+		size < sizeof(MeshCacheHeader))
+		return nullptr;
+	const MeshCacheHeader& header = *(const MeshCacheHeader*)(file.begin() + offset);
+	if(memcmp(header.magic, cacheMagic, sizeof(cacheMagic)) != 0 ||
+		header.version != MESH_CACHE_VERSION || header.byteOrder != 0x01020304 ||
+		header.vertexSize != sizeof(MeshVertex) ||
+		header.cornerSize != sizeof(Vertex))
+		return nullptr;
+	for(int i = 0; i < NumCacheSections; i++){
+		uint64_t start = header.offsets[i], count = header.counts[i];
+		if(start % 16 != 0 || start > size ||
+			count > (size - start)/sectionSizes[i])
+			return nullptr;
+	}
+	if(header.counts[FaceOffsetSection] == 0)
+		return nullptr;
+
+	// The indices are handed to the GPU, check them
+	const unsigned int* indices = section<unsigned int>(header, IndexSection);
+	uint64_t numVertices = header.counts[VertexSection];
+	for(uint64_t i = 0; i < header.counts[IndexSection]; i++)
+		if(indices[i] >= numVertices)
+			return nullptr;
+
+	// The faces cover the corners in order, from the first to the last
+	const unsigned int* faceOffsets =
+		section<unsigned int>(header, FaceOffsetSection);
+	uint64_t numFaceOffsets = header.counts[FaceOffsetSection];
+	if(faceOffsets[0] != 0 ||
+		faceOffsets[numFaceOffsets - 1] != header.counts[CornerSection])
+		return nullptr;
+	for(uint64_t i = 1; i < numFaceOffsets; i++)
+		if(faceOffsets[i] < faceOffsets[i - 1])
+			return nullptr;
+
+	// Each corner has a position, and a normal and texture coordinate or -1,
+	// as Mesh::buildTriangles requires
+	const Vertex* corners = section<Vertex>(header, CornerSection);
+	int64_t numPoints = header.counts[PointSection];
+	int64_t numNormals = header.counts[NormalSection];
+	int64_t numTextures = header.counts[TextureSection];
+	for(uint64_t i = 0; i < header.counts[CornerSection]; i++)
+		if(corners[i].pointIdx < 0 || corners[i].pointIdx >= numPoints ||
+			corners[i].normalIdx < -1 || corners[i].normalIdx >= numNormals ||
+			corners[i].textureIdx < -1 || corners[i].textureIdx >= numTextures)
+			return nullptr;
+	return &header;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Point the arrays of a mesh into a checked mesh image
+// @param file: mapped file holding the image, kept alive by the mesh
+// @param header: header of the image
+// @param mesh: mesh to load
+// @param centerOfMass: center of mass of the model
+static void
+viewImage(shared_ptr<MappedFile> file, const MeshCacheHeader& header,
+	Mesh& mesh, glm::vec3& centerOfMass){
+	mesh.points.view(section<glm::vec3>(header, PointSection),
+		header.counts[PointSection]);
+	mesh.normals.view(section<glm::vec3>(header, NormalSection),
+		header.counts[NormalSection]);
+	mesh.textures.view(section<glm::vec3>(header, TextureSection),
+		header.counts[TextureSection]);
+	mesh.corners.view(section<Vertex>(header, CornerSection),
+		header.counts[CornerSection]);
+	mesh.faceOffsets.view(section<unsigned int>(header, FaceOffsetSection),
+		header.counts[FaceOffsetSection]);
+	mesh.vertices.view(section<MeshVertex>(header, VertexSection),
+		header.counts[VertexSection]);
+	mesh.indices.view(section<unsigned int>(header, IndexSection),
+		header.counts[IndexSection]);
+	mesh.hasNormals = header.flags & HasNormals;
+	mesh.hasTexCoords = header.flags & HasTexCoords;
+	mesh.storage = file;
+	centerOfMass = glm::vec3(header.centerOfMass[0], header.centerOfMass[1],
+		header.centerOfMass[2]);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Write a mesh image. Section offsets are from the start of the
+//		   image, which must be 16-byte aligned in its file.
+// @param out: stream to write to, at the start of the image
+// @param header: header with the source fields set, or zero
+// @param path: canonical path of the OBJ, or empty
+// @param mesh: the mesh
+// @param centerOfMass: center of mass of the model
+static void
+writeImage(ostream& out, MeshCacheHeader header, const string& path,
+	const Mesh& mesh, glm::vec3 centerOfMass){
+	memcpy(header.magic, cacheMagic, sizeof(cacheMagic));
+	header.version = MESH_CACHE_VERSION;
+	header.byteOrder = 0x01020304;
+	header.vertexSize = sizeof(MeshVertex);
+	header.cornerSize = sizeof(Vertex);
+	for(int i = 0; i < 3; i++)
+		header.centerOfMass[i] = centerOfMass[i];
+	header.flags = (mesh.hasNormals ? HasNormals : 0) |
+		(mesh.hasTexCoords ? HasTexCoords : 0);
+
+	const void* data[NumCacheSections] = {path.data(),
+		mesh.points.data(), mesh.normals.data(), mesh.textures.data(),
+		mesh.corners.data(), mesh.faceOffsets.data(), mesh.vertices.data(),
+		mesh.indices.data()};
+	size_t counts[NumCacheSections] = {path.size(), mesh.points.size(),
+		mesh.normals.size(), mesh.textures.size(), mesh.corners.size(),
+		mesh.faceOffsets.size(), mesh.vertices.size(), mesh.indices.size()};
+	uint64_t offset = sizeof(MeshCacheHeader);
+	for(int i = 0; i < NumCacheSections; i++){
+		offset = (offset + 15)/16*16;
+		header.offsets[i] = offset;
+		header.counts[i] = counts[i];
+		offset += counts[i]*sectionSizes[i];
+	}
+
+	uint64_t start = out.tellp();
+	out.write((const char*)&header, sizeof(header));
+	static const char padding[16] = {0};
+	for(int i = 0; i < NumCacheSections; i++){
+		out.write(padding, start + header.offsets[i] - out.tellp());
+		out.write((const char*)data[i], counts[i]*sectionSizes[i]);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Point the arrays of a mesh into a mapped cache file
+// @param objFile: OBJ the mesh is for
+// @param mesh: mesh to load, unchanged if the cache misses
+// @param centerOfMass: center of mass of the model
+// @return: false if there is no valid, up to date cache for the OBJ
+bool
+MeshCache::load(string objFile, Mesh& mesh, glm::vec3& centerOfMass){
+	Source source;
+	if(!enabled || !stat(objFile, source))
+		return false;
+	string path = cacheFile(source);
+	shared_ptr<MappedFile> file = make_shared<MappedFile>(path);
+	if(!file->isOpen())
+		return false;
+	const MeshCacheHeader* header = readImage(*file, 0, file->size());
+	if(header == nullptr)
+		return false;
+
+	// Of this OBJ, unchanged since
+	const char* cachedPath = section<char>(*header, PathSection);
+	if(string(cachedPath, header->counts[PathSection]) != source.path ||
+		header->sourceSize != source.size)
+		return false;
+	if(header->sourceMtime != source.mtime){
+		// Touched, maybe not modified
+		MappedFile obj(objFile);
+		if(!obj.isOpen() || hash(obj.begin(), obj.end()) != header->sourceHash)
+			return false;
+		// Remember the new time so the next load skips the hash
+		int fd = open(path.c_str(), O_WRONLY);
+		if(fd >= 0){
+			pwrite(fd, &source.mtime, sizeof(source.mtime),
+				offsetof(MeshCacheHeader, sourceMtime));
+			close(fd);
+		}
+	}
+
+	viewImage(file, *header, mesh, centerOfMass);
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Write the cache file of an OBJ. Failing to write it only prints a
+//		   warning, the cache is an optimization.
+// @param objFile: OBJ the mesh was parsed from
+// @param objBegin, objEnd: contents of the OBJ, to hash
+// @param mesh: the parsed mesh
+// @param centerOfMass: center of mass of the model
+void
+MeshCache::save(string objFile, const char* objBegin, const char* objEnd,
+	const Mesh& mesh, glm::vec3 centerOfMass){
+	Source source;
+	if(!enabled || !stat(objFile, source))
+		return;
+
+	MeshCacheHeader header;
+	memset(&header, 0, sizeof(header));
+	header.sourceSize = source.size;
+	header.sourceMtime = source.mtime;
+	header.sourceHash = hash(objBegin, objEnd);
+
+	// Write a temporary file and move it in place, so a reader never maps a
+	// half written cache. The temporary file is unique to this save, as
+	// two threads may save the same cache at once.
+	string path = cacheFile(source);
+	string tempPath = path + ".XXXXXX";
+	int fd = mkstemp(&tempPath[0]);
+	if(fd < 0){
+		cerr << "Warning: Unable to write mesh cache " << path << endl;
+		return;
+	}
+	fchmod(fd, 0644);
+	close(fd);
+	ofstream out(tempPath, ios::binary);
+	writeImage(out, header, source.path, mesh, centerOfMass);
+	out.close();
+	if(!out || rename(tempPath.c_str(), path.c_str()) != 0){
+		cerr << "Warning: Unable to write mesh cache " << path << endl;
+		unlink(tempPath.c_str());
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Point the arrays of a mesh into a mesh image embedded in another
+//		   file, such as a scene bundle. The image is not tied to an OBJ.
+// @param file: mapped file holding the image, kept alive by the mesh
+// @param offset: start of the image in the file, 16-byte aligned
+// @param size: size of the image
+// @param mesh: mesh to load, unchanged if the image is invalid
+// @param centerOfMass: center of mass of the model
+// @return: false if the image is invalid
+bool
+MeshCache::view(shared_ptr<MappedFile> file, uint64_t offset, uint64_t size,
+	Mesh& mesh, glm::vec3& centerOfMass){
+	const MeshCacheHeader* header = readImage(*file, offset, size);
+	if(header == nullptr)
+		return false;
+	viewImage(file, *header, mesh, centerOfMass);
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Write a mesh image to embed in another file, at a 16-byte aligned
+//		   position of the stream
+// @param out: stream to write to
+// @param mesh: the mesh
+// @param centerOfMass: center of mass of the model
+void
+MeshCache::write(ostream& out, const Mesh& mesh, glm::vec3 centerOfMass){
+	MeshCacheHeader header;
+	memset(&header, 0, sizeof(header));
+	writeImage(out, header, "", mesh, centerOfMass);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Set where cache files go
+// @param _directory: "off" to neither read nor write caches, a directory
+//		  (created if missing) to keep them in, or "" for next to the OBJs
+void
+MeshCache::setDirectory(string _directory){
+	enabled = _directory != "off";
+	directory = enabled ? _directory : "";
+	if(!directory.empty())
+		mkdir(directory.c_str(), 0755);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: 64-bit FNV-1a hash of a range of bytes
+uint64_t
+MeshCache::hash(const char* begin, const char* end){
+	uint64_t h = 14695981039346656037ull;
+	for(const char* p = begin; p < end; p++){
+		h ^= (unsigned char)*p;
+		h *= 1099511628211ull;
+	}
+	return h;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Identify an OBJ file
+// @param objFile: path of the OBJ
+// @param source: canonical path, size and modification time of the OBJ
+// @return: false if the OBJ does not exist
+bool
+MeshCache::stat(string objFile, Source& source){
+	char canonical[PATH_MAX];
+	struct stat info;
+	if(realpath(objFile.c_str(), canonical) == nullptr ||
+		::stat(canonical, &info) != 0)
+		return false;
+	source.path = canonical;
+	source.size = info.st_size;
+#if defined(OSX)
+	source.mtime = info.st_mtimespec.tv_sec*1000000000ll +
+		info.st_mtimespec.tv_nsec;
+#else
+	source.mtime = info.st_mtim.tv_sec*1000000000ll + info.st_mtim.tv_nsec;
+#endif
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Path of the cache file of an OBJ. In a cache directory, the name
+//		   carries a hash of the OBJ's path so equal names do not collide.
+string
+MeshCache::cacheFile(const Source& source){
+	if(directory.empty())
+		return source.path + ".meshcache";
+	size_t slash = source.path.find_last_of('/');
+	char pathHash[17];
+	snprintf(pathHash, sizeof(pathHash), "%016llx", (unsigned long long)
+		hash(source.path.data(), source.path.data() + source.path.size()));
+	return directory + "/" + source.path.substr(slash + 1) + "." + pathHash +
+		".meshcache";
+}
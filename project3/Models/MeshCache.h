@@ -0,0 +1,54 @@
+//////////////////////////////////////////////////////////////////////////////
+// @brief: This class represents the binary cache of parsed OBJ meshes. A
+//		   cache file holds every array of a Mesh, ready to use, plus the
+//		   model's center of mass. Loading maps the file and points the mesh
+//		   arrays into it, without parsing or copying.
+//		   A cache file belongs to the OBJ at one canonical path and is used
+//		   while the OBJ keeps its size and modification time; if only the
+//		   time changed, the contents are hashed and compared. Anything else
+//		   (another version or platform, a damaged file) makes the cache
+//		   miss, and the OBJ is parsed and the cache written again.
+//		   Cache files are written next to their OBJ (lake.obj.meshcache)
+//		   unless a cache directory is set.
+//		   The same mesh images can be embedded in other files, such as
+//		   scene bundles, where they are not tied to an OBJ.
+#ifndef MESHCACHE_H
+#define MESHCACHE_H
+#include <string>
+#include <cstdint>
+#include <ostream>
+#include "Mesh.h"
+
+using namespace std;
+
+// Bump when the layout of the file or of the cached structs changes
+#define MESH_CACHE_VERSION 1
+
+class MeshCache {
+public:
+	static bool load(string objFile, Mesh& mesh, glm::vec3& centerOfMass);
+	static void save(string objFile, const char* objBegin, const char* objEnd,
+		const Mesh& mesh, glm::vec3 centerOfMass);
+	static bool view(shared_ptr<MappedFile> file, uint64_t offset,
+		uint64_t size, Mesh& mesh, glm::vec3& centerOfMass);
+	static void write(ostream& out, const Mesh& mesh, glm::vec3 centerOfMass);
+	static void setDirectory(string directory);
+	static uint64_t hash(const char* begin, const char* end);
+
+private:
+	//////////////////////////////////////////////////////////////////////////
+	// @brief: Identity of an OBJ file
+	struct Source {
+		string path;		//< Canonical path
+		uint64_t size;		//< Size in bytes
+		int64_t mtime;		//< Modification time in ns
+	};
+
+	static bool enabled;		//< Whether caches are read and written
+	static string directory;	//< Directory of the cache files, empty for
+								//< next to the OBJ
+
+	static bool stat(string objFile, Source& source);
+	static string cacheFile(const Source& source);
+};
+#endif
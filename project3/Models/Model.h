@@ -13,6 +13,7 @@
 #include <vector>
 #include <stdlib.h>
 #include <string>
+#include <memory>
 // GLM
 #include "../Utilities/glm/glm.hpp"
 #define GLM_ENABLE_EXPERIMENTAL 
@@ -21,20 +22,13 @@
 #include "../Utilities/glm/geometric.hpp" // For normalize, cross, dot product, scalar multiply, etc.
 #include "../Utilities/glm/gtx/vector_angle.hpp" // For calculating angle between vectors
 
-#if   defined(OSX)
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wdeprecated-declarations"
-#include <GLUT/glut.h>
-#elif defined(LINUX)
-#include <GL/glut.h>
-
-#endif
-
-#include "Face.h"
+#include "ModelAsset.h"
 
 using namespace std;
 #define PI 3.14159265
 
+class MeshBuffer;
+
 // Different types of style
 enum Style{
   LINE,
@@ -42,13 +36,23 @@ enum Style{
   POINT
 };
 
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Placement of a model, as read from a static models file
+struct ModelDescription {
+	string file;								//< OBJ of the model
+	string name;								//< Name of the model
+	glm::vec3 pos{0.f, 0.f, 0.f};				//< Position in the world
+	glm::vec3 orientation{0.f, 0.f, 0.f};		//< Orientation
+	glm::vec3 scale{1.f, 1.f, 1.f};				//< Factor to scale by
+	glm::vec3 color{0.6f, 0.6f, 0.6f};			//< Color
+	shared_ptr<const ModelAsset> asset;			//< Geometry already loaded with
+												//< the scene, null to load file
+};
+
 class Model {
 private:
-	vector<glm::vec3> points;	        //< Vector of the model's vertices 
-	vector<glm::vec3> normals;			//< Vector of the model's normals
-	vector<glm::vec3> textures;		    //< Vector of the model's textures
-	vector<shared_ptr<Face>> facesTriangle;	  	 //< Vector of the model's triangular faces
-	vector<shared_ptr<Face>> facesQuad;	   		 //< Vector of the model's quadrilateral faces
+	shared_ptr<const ModelAsset> asset;	//< Geometry, shared by the models of
+										//< the same OBJ
 
 	string name;						//< name of model
 	Style style{FILL};				    //< style the model is drawn in
@@ -56,31 +60,28 @@ private:
 	glm::vec3 pos;						//< position of model in the world
 	glm::vec3 orientation;				//< orientation of model
 	glm::vec3 scale;					//< factor to scale by
-	glm::vec3 centerOfMass;				//< To scale then translate correctly
 
-	void getTokens(string input);
-	void storeValue(string input, vector<glm::vec3>& vec);
-	void readFace(string input);
-	void drawFace(shared_ptr<Face> face);
+	void drawInstance(MeshBuffer* buffer);
+	void drawImmediate();
 	void changeOrientation();
+	MeshBuffer& getMeshBuffer();
 
 public:
 
 	Model(Model& model);
 	Model(string inputFile, string _name, glm::vec3 _pos, glm::vec3 _orientation, glm::vec3  scale, glm::vec3 _color);
+	Model(shared_ptr<const ModelAsset> _asset, const ModelDescription& description);
 	void draw();
-	static void parseInModels(string inputFile, vector<shared_ptr<Model>>& models);
+	static void drawAll(const vector<shared_ptr<Model>>& models);
+	static void parseInModels(string inputFile, vector<ModelDescription>& models);
 	void setColor(glm::vec3 _color){ color = _color;}
-	static void tokenize(string input, string split, vector<string>& vec);
 
 	// Getter methods
-	const vector<glm::vec3>& getPoints() { return points; }
-	const vector<glm::vec3>& getNormals() { return normals; }
-	const vector<glm::vec3>& getTextures() { return textures; }
+	const MeshArray<glm::vec3>& getPoints() { return asset->mesh.points; }
+	const MeshArray<glm::vec3>& getNormals() { return asset->mesh.normals; }
+	const MeshArray<glm::vec3>& getTextures() { return asset->mesh.textures; }
+	const Mesh& getMesh() { return asset->mesh; }
 
 };
 
-#if   defined(OSX)
-#pragma clang diagnostic pop
-#endif
 #endif
\ No newline at end of file
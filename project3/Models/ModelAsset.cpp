@@ -0,0 +1,98 @@
+#include "ModelAsset.h"
+#include "ObjParser.h"
+#include "MeshCache.h"
+#include "../Utilities/MappedFile.h"
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+
+unordered_map<string, weak_ptr<const ModelAsset>> ModelAsset::assets;
+mutex ModelAsset::assetLock;
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Get the asset of an OBJ file, loading it unless it is in use.
+//		   Exits if the OBJ can not be loaded, so only for the main thread.
+// @param objFile: path of the OBJ
+// @return: the shared asset
+shared_ptr<const ModelAsset>
+ModelAsset::load(string objFile){
+	string error;
+	shared_ptr<const ModelAsset> asset = load(objFile, error);
+	if(!asset){
+		cerr << "Error: " << error << endl;
+		exit(1);
+	}
+	return asset;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Get the asset of an OBJ file, loading it unless it is in use.
+//		   The lock is not held while loading, so a file loaded by two
+//		   threads at the same time is parsed twice and one copy kept.
+// @param objFile: path of the OBJ
+// @param error: set to why the OBJ could not be loaded
+// @param numThreads: most threads to parse the OBJ with, 0 for one per core
+// @return: the shared asset, null if the OBJ could not be loaded
+shared_ptr<const ModelAsset>
+ModelAsset::load(string objFile, string& error, int numThreads){
+	// Different spellings of the same path share the asset
+	char canonical[PATH_MAX];
+	string key = realpath(objFile.c_str(), canonical) ? string(canonical) : objFile;
+	{
+		lock_guard<mutex> guard(assetLock);
+		shared_ptr<const ModelAsset> asset = assets[key].lock();
+		if(asset)
+			return asset;
+	}
+
+	shared_ptr<ModelAsset> loaded = make_shared<ModelAsset>();
+	loaded->file = key;
+	if(!loaded->parse(objFile, error, numThreads))
+		return nullptr;
+	lock_guard<mutex> guard(assetLock);
+	assets[key] = loaded;
+	return loaded;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Fill the mesh and center of mass from the mesh cache, else from
+//		   the OBJ itself
+// @param objFile: path of the OBJ
+// @param error: set to why the OBJ could not be loaded
+// @param numThreads: most threads to parse the OBJ with, 0 for one per core
+// @return: false if the OBJ could not be loaded
+bool
+ModelAsset::parse(string objFile, string& error, int numThreads){
+	// A cached mesh is used as is, straight from the mapped cache file
+	if(MeshCache::load(objFile, mesh, centerOfMass))
+		return true;
+
+	// Parse the OBJ in place from the mapped file
+	MappedFile input(objFile);
+	if(!input.isOpen()){
+		error = "Unable to open file " + objFile;
+		return false;
+	}
+	ObjParser parser(mesh);
+	if(!parser.parse(input.begin(), input.end(), numThreads)){
+		error = objFile + ", " + parser.getError();
+		return false;
+	}
+
+	// The normals and texture coordinates have always been summed in with
+	// the positions; scenes are placed relative to this point
+	for(auto& point : mesh.points)
+		centerOfMass += point;
+	for(auto& normal : mesh.normals)
+		centerOfMass += normal;
+	for(auto& texture : mesh.textures)
+		centerOfMass += texture;
+	centerOfMass /= mesh.points.size();
+
+	if(!mesh.buildTriangles()){
+		error = "Face index out of range in " + objFile;
+		return false;
+	}
+	MeshCache::save(objFile, input.begin(), input.end(), mesh, centerOfMass);
+	return true;
+}
@@ -0,0 +1,39 @@
+//////////////////////////////////////////////////////////////////////////////
+// @brief: This class represents the geometry loaded from one OBJ file, shared
+//		   by every Model placed from that file. Assets are cached by the
+//		   canonical path of their OBJ: loading a file that is already loaded
+//		   returns the same asset, which is immutable once loaded. An asset is
+//		   freed with the last Model using it. Assets can be loaded from
+//		   several threads at once.
+#ifndef MODELASSET_H
+#define MODELASSET_H
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <mutex>
+#include "Mesh.h"
+
+using namespace std;
+
+class MeshBuffer;
+
+class ModelAsset {
+public:
+	Mesh mesh;								//< Attributes and faces
+	glm::vec3 centerOfMass{0.f, 0.f, 0.f};	//< To scale then translate
+											//< correctly
+	string file;							//< Canonical path of the OBJ
+	mutable shared_ptr<MeshBuffer> meshBuffer;	//< Mesh uploaded to the GPU,
+												//< made on first draw
+
+	static shared_ptr<const ModelAsset> load(string objFile);
+	static shared_ptr<const ModelAsset> load(string objFile, string& error,
+		int numThreads = 0);
+
+private:
+	static unordered_map<string, weak_ptr<const ModelAsset>> assets;	//< Loaded
+																		//< assets
+	static mutex assetLock;				//< Guards assets
+	bool parse(string objFile, string& error, int numThreads);
+};
+#endif
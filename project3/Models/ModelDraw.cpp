@@ -0,0 +1,126 @@
+#include "Model.h"
+#include "MeshBuffer.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Draw model
+//		   Polygons were split into triangles when the mesh was built
+void Model::draw(){
+	if(glHasBufferObjects()){
+		MeshBuffer& buffer = getMeshBuffer();
+		buffer.bind();
+		drawInstance(&buffer);
+		buffer.unbind();
+	}
+	else
+		drawInstance(nullptr);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Draw models, the models sharing a mesh one after the other so its
+//		   buffers are bound once for all of them. Meshes are drawn in the
+//		   order they first appear.
+// @param models: models to draw
+void Model::drawAll(const vector<shared_ptr<Model>>& models){
+	if(!glHasBufferObjects()){
+		for(auto& model : models)
+			model->drawInstance(nullptr);
+		return;
+	}
+
+	unordered_map<const ModelAsset*, size_t> groups;
+	vector<vector<Model*>> instances;
+	for(auto& model : models){
+		auto group = groups.emplace(model->asset.get(), instances.size());
+		if(group.second)
+			instances.emplace_back();
+		instances[group.first->second].push_back(model.get());
+	}
+	for(auto& group : instances){
+		MeshBuffer& buffer = group.front()->getMeshBuffer();
+		buffer.bind();
+		for(Model* model : group)
+			model->drawInstance(&buffer);
+		buffer.unbind();
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Draw the model with its own style, color and transform
+// @param buffer: bound buffer of the mesh, nullptr to draw in immediate mode
+void Model::drawInstance(MeshBuffer* buffer){
+	// Style and color
+  	glColor3f(color.x, color.y, color.z);
+  	if(style == FILL)
+  		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+  	else if(style == POINT)
+  		glPolygonMode(GL_FRONT_AND_BACK, GL_POINT);
+  	else if(style == LINE)
+  		glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+
+
+  	// Transformations
+  	const glm::vec3& centerOfMass = asset->centerOfMass;
+  	glPushMatrix();
+  	glTranslatef(pos.x, pos.y, pos.z);
+  	glScalef(scale.x, scale.y, scale.z);
+  	changeOrientation();
+  	// Translated back to origin before any non-translation transformation
+  	glTranslatef(-centerOfMass.x, -centerOfMass.y, -centerOfMass.z);
+
+  	// Draw
+  	if(buffer)
+  		buffer->drawElements();
+  	else
+  		drawImmediate();
+  	glPopMatrix();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: GPU buffer of the mesh, uploaded by the first model of the mesh
+//		   drawn
+MeshBuffer& Model::getMeshBuffer(){
+	if(!asset->meshBuffer)
+		asset->meshBuffer = make_shared<MeshBuffer>(asset->mesh);
+	return *asset->meshBuffer;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Draw the mesh one vertex at a time, for contexts without buffer
+//		   objects
+void Model::drawImmediate(){
+	const Mesh& mesh = asset->mesh;
+	glBegin(GL_TRIANGLES);
+	for(unsigned int index : mesh.indices){
+		const MeshVertex& vertex = mesh.vertices[index];
+		if(mesh.hasNormals)
+			glNormal3f(vertex.normal.x, vertex.normal.y, vertex.normal.z);
+		if(mesh.hasTexCoords)
+			glTexCoord2f(vertex.texCoord.x, vertex.texCoord.y);
+		glVertex3f(vertex.pos.x, vertex.pos.y, vertex.pos.z);
+	}
+	glEnd();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Change orientation of model.
+// @note: I could not find what functions of OpenGL can change 3D orientation, so
+// I devised my own method, though I think it's messy and not 100% sure if it's correct.
+void Model::changeOrientation(){
+	// Change the xz-orientation of model
+	glm::vec3 vec1 = glm::normalize(glm::vec3(orientation.x, 0, orientation.z));
+	// Default xz orientation of model (without any orientation input) is (0,0,1)
+	// Find the angle to rotate the model from default orientation to desired orientation,
+	// with reference to the y-axis
+	// Note that argument to glm::orientedAngle need to be normalized
+	float angle = glm::orientedAngle(glm::vec3(0,0,1), vec1, glm::vec3(0,1,0));
+	// convert angle from radians to degrees then rotate model with reference to y-axis
+  	glRotatef(angle/PI * 180, 0, 1, 0);
+
+  	// Change the y-orientation of model
+  	glm::vec3 vec2(0, orientation.y, 1);
+  	// Find the angle to rotate the model from y = 0 to y = orientation.y, keeping xz orientation
+  	// the same
+  	float angle2 = glm::orientedAngle(glm::vec3(0,0,1),
+  		glm::normalize(glm::vec3(0,orientation.y,1)), glm::vec3(1,0,0));
+   	glRotatef(angle2/PI * 180, 1, 0, 0); 
+}
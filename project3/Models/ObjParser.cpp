@@ -0,0 +1,327 @@
+#include "ObjParser.h"
+#include "../Utilities/ThreadPool.h"
+#include <charconv>
+#include <cstring>
+#include <cstdlib>
+
+// Kinds of records
+enum RecordType {PointRecord, NormalRecord, TextureRecord, FaceRecord,
+	OtherRecord};
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Whether c separates the fields of a record
+static inline bool
+isBlank(char c){
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Advance p past blanks
+static inline const char*
+skipBlanks(const char* p, const char* end){
+	while(p < end && isBlank(*p))
+		p++;
+	return p;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: End of the line starting at p
+static inline const char*
+endOfLine(const char* p, const char* end){
+	const char* eol = (const char*)memchr(p, '\n', end - p);
+	return eol != nullptr ? eol : end;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Kind of a record
+// @param p: start of the line, advanced past the keyword
+// @param eol: end of the line
+static RecordType
+recordType(const char*& p, const char* eol){
+	p = skipBlanks(p, eol);
+	if(eol - p >= 2 && isBlank(p[1])){
+		p += 1;
+		if(p[-1] == 'v')
+			return PointRecord;
+		if(p[-1] == 'f')
+			return FaceRecord;
+	}
+	else if(eol - p >= 3 && p[0] == 'v' && isBlank(p[2])){
+		p += 2;
+		if(p[-1] == 'n')
+			return NormalRecord;
+		if(p[-1] == 't')
+			return TextureRecord;
+	}
+	return OtherRecord;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Read a number. Rounds through double like atof did, so meshes come
+//		   out bit for bit as before.
+// @param p: start of the number, advanced past it
+// @param end: end of the line
+// @param value: number read
+// @return: false if no number starts at p
+static bool
+scanFloat(const char*& p, const char* end, float& value){
+	if(p < end && *p == '+')
+		p++;
+	double number;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+	from_chars_result result = from_chars(p, end, number);
+	if(result.ec != errc())
+		return false;
+	p = result.ptr;
+#else
+	// Standard libraries without floating point from_chars: strtod on a
+	// terminated copy, as the mapped file need not end in a terminator
+	char digits[64];
+	size_t n = 0;
+	while(p + n < end && n < sizeof(digits) - 1 && !isBlank(p[n]))
+		n++;
+	memcpy(digits, p, n);
+	digits[n] = '\0';
+	char* last;
+	number = strtod(digits, &last);
+	if(last == digits)
+		return false;
+	p += last - digits;
+#endif
+	value = (float)number;
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Constructor
+// @param _mesh: mesh to fill, its attributes and faces are replaced
+ObjParser::ObjParser(Mesh& _mesh) : mesh(_mesh){
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Parse OBJ text
+// @param begin, end: the characters, need not be terminated
+// @param numThreads: most threads to parse with, 0 for one per core. Files
+//		  under OBJ_PARALLEL_BYTES are parsed on one.
+// @return: false on a malformed record, see getError()
+bool
+ObjParser::parse(const char* begin, const char* end, int numThreads){
+	size_t size = end - begin;
+	if(numThreads <= 0)
+		numThreads = max(1u, thread::hardware_concurrency());
+	if(size < OBJ_PARALLEL_BYTES)
+		numThreads = 1;
+
+	// Cut at the first line break after every chunkSize bytes
+	size_t numChunks = numThreads > 1 ? numThreads*OBJ_CHUNKS_PER_THREAD : 1;
+	size_t chunkSize = size/numChunks + 1;
+	vector<Chunk> chunks;
+	for(const char* p = begin; p < end; ){
+		Chunk chunk;
+		chunk.begin = p;
+		chunk.end = size_t(end - p) > chunkSize ?
+			endOfLine(p + chunkSize, end) : end;
+		if(chunk.end < end)
+			chunk.end++;
+		p = chunk.end;
+		chunks.push_back(move(chunk));
+	}
+
+	unique_ptr<ThreadPool> pool;
+	if(numThreads > 1 && chunks.size() > 1)
+		pool.reset(new ThreadPool(numThreads));
+	auto forEachChunk = [&](void (ObjParser::*pass)(Chunk&)){
+		if(!pool){
+			for(auto& chunk : chunks)
+				(this->*pass)(chunk);
+			return;
+		}
+		pool->parallelFor(0, chunks.size(), 1, [&](size_t first, size_t last){
+			for(size_t i = first; i < last; i++)
+				(this->*pass)(chunks[i]);
+		});
+	};
+
+	// First pass: count, then place every chunk after the ones before it
+	forEachChunk(&ObjParser::countChunk);
+	Chunk total;
+	for(auto& chunk : chunks){
+		chunk.firstLine = total.numLines;
+		chunk.firstPoint = total.numPoints;
+		chunk.firstNormal = total.numNormals;
+		chunk.firstTexture = total.numTextures;
+		chunk.firstFace = total.numFaces;
+		chunk.firstCorner = total.numCorners;
+		total.numLines += chunk.numLines;
+		total.numPoints += chunk.numPoints;
+		total.numNormals += chunk.numNormals;
+		total.numTextures += chunk.numTextures;
+		total.numFaces += chunk.numFaces;
+		total.numCorners += chunk.numCorners;
+	}
+	mesh.points.resize(total.numPoints);
+	mesh.normals.resize(total.numNormals);
+	mesh.textures.resize(total.numTextures);
+	mesh.corners.resize(total.numCorners);
+	mesh.faceOffsets.resize(total.numFaces + 1);
+	mesh.faceOffsets[0] = 0;
+
+	// Second pass: parse into place
+	forEachChunk(&ObjParser::parseChunk);
+	for(auto& chunk : chunks){
+		if(!chunk.error.empty()){
+			error = chunk.error;
+			return false;
+		}
+	}
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Count the lines and records of a chunk. Faces count when they have
+//		   3 or more corners, the ones parseChunk keeps.
+void
+ObjParser::countChunk(Chunk& chunk){
+	for(const char* p = chunk.begin; p < chunk.end; ){
+		const char* eol = endOfLine(p, chunk.end);
+		chunk.numLines++;
+		switch(recordType(p, eol)){
+			case PointRecord: chunk.numPoints++; break;
+			case NormalRecord: chunk.numNormals++; break;
+			case TextureRecord: chunk.numTextures++; break;
+			case FaceRecord: {
+				size_t numCorners = 0;
+				while((p = skipBlanks(p, eol)) < eol){
+					numCorners++;
+					while(p < eol && !isBlank(*p))
+						p++;
+				}
+				if(numCorners >= 3){
+					chunk.numFaces++;
+					chunk.numCorners += numCorners;
+				}
+				break;
+			}
+			default: break;
+		}
+		p = eol + 1;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Parse the records of a chunk into their place in the mesh. Faces
+//		   with fewer than 3 corners are skipped. Stops at the first
+//		   malformed line, recorded in the chunk's error.
+void
+ObjParser::parseChunk(Chunk& chunk){
+	size_t line = chunk.firstLine;
+	size_t point = chunk.firstPoint, normal = chunk.firstNormal,
+		texture = chunk.firstTexture, face = chunk.firstFace,
+		corner = chunk.firstCorner;
+	const char* what = nullptr;
+	for(const char* p = chunk.begin; p < chunk.end && what == nullptr; ){
+		const char* eol = endOfLine(p, chunk.end);
+		line++;
+		switch(recordType(p, eol)){
+			case PointRecord:
+				if(!parseVector(p, eol, mesh.points[point++]))
+					what = "malformed number";
+				break;
+			case NormalRecord:
+				if(!parseVector(p, eol, mesh.normals[normal++]))
+					what = "malformed number";
+				break;
+			case TextureRecord:
+				if(!parseVector(p, eol, mesh.textures[texture++]))
+					what = "malformed number";
+				break;
+			case FaceRecord: {
+				vector<Vertex>& corners = chunk.faceCorners;
+				if(!parseFace(p, eol, corners, point, normal, texture)){
+					what = "malformed face corner";
+					break;
+				}
+				if(corners.size() < 3)
+					break;
+				copy(corners.begin(), corners.end(), mesh.corners.begin() + corner);
+				corner += corners.size();
+				mesh.faceOffsets[++face] = corner;
+				break;
+			}
+			default: break;
+		}
+		p = eol + 1;
+	}
+	if(what != nullptr)
+		chunk.error = "line " + to_string(line) + ": " + what;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Read the x, y and optional z (default 0) of a v, vt or vn record
+// @param p: after the keyword
+// @param end: end of the line
+// @param value: attribute read
+bool
+ObjParser::parseVector(const char* p, const char* end, glm::vec3& value){
+	value = glm::vec3(0.f);
+	for(int i = 0; i < 3; i++){
+		p = skipBlanks(p, end);
+		if(p == end && i == 2)
+			break;
+		if(!scanFloat(p, end, value[i]) || (p < end && !isBlank(*p)))
+			return false;
+	}
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Read the corners of an f record
+// @param p: after the keyword
+// @param end: end of the line
+// @param corners: corners read
+// @param numPoints, numNormals, numTextures: attributes read before the face,
+//		  which negative indices count back from
+bool
+ObjParser::parseFace(const char* p, const char* end, vector<Vertex>& corners,
+	size_t numPoints, size_t numNormals, size_t numTextures){
+	corners.clear();
+	while((p = skipBlanks(p, end)) < end){
+		Vertex corner;
+		if(!parseIndex(p, end, numPoints, corner.pointIdx))
+			return false;
+		if(p < end && *p == '/'){
+			p++;
+			// v//vn has no texture index
+			if(p < end && *p != '/' &&
+				!parseIndex(p, end, numTextures, corner.textureIdx))
+				return false;
+			if(p < end && *p == '/'){
+				p++;
+				if(!parseIndex(p, end, numNormals, corner.normalIdx))
+					return false;
+			}
+		}
+		if(p < end && !isBlank(*p))
+			return false;
+		corners.push_back(corner);
+	}
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Read a 1-based OBJ index, or a negative one relative to the end of
+//		   the attributes read so far
+// @param p: start of the index, advanced past it
+// @param end: end of the line
+// @param count: number of attributes read so far
+// @param index: 0-based index
+bool
+ObjParser::parseIndex(const char*& p, const char* end, size_t count, int& index){
+	int value;
+	from_chars_result result = from_chars(p, end, value);
+	if(result.ec != errc() || value == 0)
+		return false;
+	p = result.ptr;
+	index = value > 0 ? value - 1 : (int)count + value;
+	return true;
+}
@@ -0,0 +1,56 @@
+//////////////////////////////////////////////////////////////////////////////
+// @brief: This class represents a parser of Wavefront OBJ text into a Mesh.
+//		   It scans the characters in place and converts numbers with
+//		   std::from_chars, so parsing does not allocate apart from sizing
+//		   the mesh arrays. Records other than v, vt, vn and f are skipped.
+//		   Faces accept the corner styles v, v/vt, v//vn and v/vt/vn, and
+//		   negative (relative) indices.
+//		   The text is cut into chunks at line boundaries and parsed in two
+//		   passes: the first counts the records of every chunk, so each
+//		   chunk knows where its records go in the mesh arrays, and the
+//		   second parses the chunks straight into place. Large files spread
+//		   both passes over a thread pool; the mesh is the same either way.
+#ifndef OBJPARSER_H
+#define OBJPARSER_H
+#include <string>
+#include "Mesh.h"
+
+using namespace std;
+
+// Files from this size up are parsed on several threads
+#define OBJ_PARALLEL_BYTES (1 << 20)
+// Chunks dealt to each thread, for load balancing
+#define OBJ_CHUNKS_PER_THREAD 4
+
+class ObjParser {
+public:
+	ObjParser(Mesh& mesh);
+	bool parse(const char* begin, const char* end, int numThreads = 0);
+	const string& getError() { return error; }
+
+private:
+	//////////////////////////////////////////////////////////////////////////
+	// @brief: Whole lines of the text, with the number of records in them
+	//		   and the index of their first record of each kind
+	struct Chunk {
+		const char* begin;
+		const char* end;
+		size_t numLines{0}, numPoints{0}, numNormals{0}, numTextures{0},
+			numFaces{0}, numCorners{0};
+		size_t firstLine{0}, firstPoint{0}, firstNormal{0}, firstTexture{0},
+			firstFace{0}, firstCorner{0};
+		vector<Vertex> faceCorners;	//< Corners of the face being read
+		string error;				//< First malformed line of the chunk
+	};
+
+	Mesh& mesh;					//< Mesh the records are written to
+	string error;				//< Description of the first malformed line
+
+	void countChunk(Chunk& chunk);
+	void parseChunk(Chunk& chunk);
+	bool parseVector(const char* p, const char* end, glm::vec3& value);
+	bool parseFace(const char* p, const char* end, vector<Vertex>& corners,
+		size_t numPoints, size_t numNormals, size_t numTextures);
+	bool parseIndex(const char*& p, const char* end, size_t count, int& index);
+};
+#endif
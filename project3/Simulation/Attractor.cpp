@@ -1,23 +1,20 @@
 #include "Attractor.h"
 
-Attractor::Attractor(glm::vec3 pos, float range, float strength){
-	this->pos = pos;
-	this->range = range;
-	this->strength = strength;
+Attractor::Attractor(glm::vec3 pos, float range, float strength)
+	: ForceEmitter(pos, range, strength){
 }
 
 //////////////////////////////////////////////////////////////////////////////
-// @brief: retrieve force of attractor acting on particle
-// @param p: given particle
-glm::vec3 
-Attractor::getForce(shared_ptr<Particle> p){
-	glm::vec3 force = glm::vec3(0,0,0);
-	if(!activated)
-		return force;
-	glm::vec3 pPos = p->getCurrentState().pos;
-	glm::vec3 dir = pos - pPos;
-	if(glm::length(dir) < range){
-		force += (dir*(strength));
+// @brief: Add force of attractor acting on each particle of a batch
+// @param positions: positions of the n particles
+// @param n: number of particles
+// @param forces: forces of the n particles, accumulated into
+void
+Attractor::addForces(const glm::vec3* positions, size_t n, glm::vec3* forces){
+	for(size_t i = 0; i < n; i++){
+		glm::vec3 dir = pos - positions[i];
+		if(glm::length(dir) < range){
+			forces[i] += (dir*(strength));
+		}
 	}
-	return force;
-}
\ No newline at end of file
+}
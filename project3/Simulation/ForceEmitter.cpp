@@ -0,0 +1,41 @@
+#include "ForceEmitter.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Constructor
+// @param pos: position of emitter
+// @param range: range emitter can affect other particles
+// @param strength: strength of the force from emitter
+ForceEmitter::ForceEmitter(glm::vec3 pos, float range, float strength){
+	this->pos = pos;
+	this->range = range;
+	this->strength = strength;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Add the force of the emitter acting on a batch of particles
+// @param positions: positions of the n particles
+// @param n: number of particles
+// @param boundsMin: minimum corner of the box bounding the positions
+// @param boundsMax: maximum corner of the box bounding the positions
+// @param forces: forces of the n particles, accumulated into
+void
+ForceEmitter::accumulateForces(const glm::vec3* positions, size_t n,
+	glm::vec3 boundsMin, glm::vec3 boundsMax, glm::vec3* forces){
+	if(!activated || !reaches(boundsMin, boundsMax))
+		return;
+	addForces(positions, n, forces);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Check whether the range sphere of the emitter overlaps a box
+// @param boundsMin: minimum corner of the box
+// @param boundsMax: maximum corner of the box
+// @return: false only if no point in the box is within range
+bool
+ForceEmitter::reaches(glm::vec3 boundsMin, glm::vec3 boundsMax){
+	glm::vec3 closest = glm::clamp(pos, boundsMin, boundsMax);
+	glm::vec3 dir = closest - pos;
+	// Slightly conservative so rounding never culls an in-range particle
+	float reach = range*1.001f;
+	return glm::dot(dir, dir) <= reach*reach;
+}
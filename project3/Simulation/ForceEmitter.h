@@ -0,0 +1,43 @@
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Base class of the point force emitters (attractors, repellers).
+//		   Forces are evaluated for a whole batch of particle positions in
+//		   one call; an inactive emitter, or one whose range does not reach
+//		   the bounding box of the batch, skips the batch entirely.
+#ifndef FORCEEMITTER_H
+#define FORCEEMITTER_H
+#include "Particle.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Parameters of an emitter, as listed in the scene's input file
+struct EmitterDescription {
+	glm::vec3 pos{0.f, 0.f, 0.f};	///< Position of emitter
+	float range{0.f};				///< Range emitter can affect particles
+	float strength{0.f};			///< Strength of the force from emitter
+
+	bool operator==(const EmitterDescription& other) const {
+		return pos == other.pos && range == other.range &&
+			strength == other.strength;
+	}
+};
+
+class ForceEmitter {
+public:
+	ForceEmitter(glm::vec3 pos, float range, float strength);
+	virtual ~ForceEmitter() {}
+	void accumulateForces(const glm::vec3* positions, size_t n,
+		glm::vec3 boundsMin, glm::vec3 boundsMax, glm::vec3* forces);
+	glm::vec3 getPos(){ return pos;}
+	void toggleActivate(){ activated = !activated;}
+protected:
+	glm::vec3 pos;				///< Position of emitter
+	float range;				///< Range emitter can affect other particles
+	float strength;				///< Strength of the force from emitter
+	bool activated{false};		///< True if activated, false if not
+								///< Only serves the purpose of demonstration
+
+	bool reaches(glm::vec3 boundsMin, glm::vec3 boundsMax);
+	// Add the force on each in-range particle of a batch to forces
+	virtual void addForces(const glm::vec3* positions, size_t n,
+		glm::vec3* forces) = 0;
+};
+#endif
@@ -0,0 +1,193 @@
+#include "Integrator.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define INTEGRATOR_X86
+#include <immintrin.h>
+#endif
+
+// Signature shared by every kernel
+typedef void (*IntegrateFunc)(float* pos, float* vel, float* acc,
+	const float* force, size_t n, float invMass, float maxVel, float t);
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Scalar kernel, also used for the particles left over by the
+//		   vector kernels
+// @param pos, vel, acc: interleaved x,y,z arrays of n particles, updated
+// @param force: interleaved x,y,z forces of n particles
+// @param n: number of particles
+// @param invMass: 1/mass of the particles
+// @param maxVel: maximum velocity of the particles
+// @param t: timestep value
+static void
+integrateScalar(float* pos, float* vel, float* acc, const float* force,
+	size_t n, float invMass, float maxVel, float t){
+	for(size_t i = 0; i < n; i++){
+		glm::vec3 a = glm::vec3(force[3*i], force[3*i+1], force[3*i+2])*invMass;
+		glm::vec3 v = glm::vec3(vel[3*i], vel[3*i+1], vel[3*i+2]) + a*t;
+		if(glm::length(v) > maxVel)
+			v = glm::normalize(v)*maxVel;
+		glm::vec3 p = glm::vec3(pos[3*i], pos[3*i+1], pos[3*i+2]) + v*t;
+		for(int k = 0; k < 3; k++){
+			acc[3*i+k] = a[k];
+			vel[3*i+k] = v[k];
+			pos[3*i+k] = p[k];
+		}
+	}
+}
+
+#ifdef INTEGRATOR_X86
+//////////////////////////////////////////////////////////////////////////////
+// @brief: SSE2 kernel, 4 particles (12 floats, 3 registers) per iteration.
+//		   The element-wise steps run on the interleaved floats directly; only
+//		   the per-particle squared length needs the x,y,z lanes transposed.
+static void
+integrateSSE2(float* pos, float* vel, float* acc, const float* force,
+	size_t n, float invMass, float maxVel, float t){
+	const __m128 vInvMass = _mm_set1_ps(invMass);
+	const __m128 vMaxVel = _mm_set1_ps(maxVel);
+	const __m128 vT = _mm_set1_ps(t);
+	const __m128 one = _mm_set1_ps(1.f);
+	size_t i = 0;
+	for(; i + 4 <= n; i += 4){
+		size_t o = 3*i;
+		__m128 a[3], v[3], sq[3];
+		for(int k = 0; k < 3; k++){
+			a[k] = _mm_mul_ps(_mm_loadu_ps(force + o + 4*k), vInvMass);
+			v[k] = _mm_add_ps(_mm_loadu_ps(vel + o + 4*k), _mm_mul_ps(a[k], vT));
+			sq[k] = _mm_mul_ps(v[k], v[k]);
+		}
+		// sq = [x0 y0 z0 x1] [y1 z1 x2 y2] [z2 x3 y3 z3] -> per-lane x, y, z
+		__m128 x = _mm_shuffle_ps(_mm_shuffle_ps(sq[0], sq[0], _MM_SHUFFLE(3,3,0,0)),
+			_mm_shuffle_ps(sq[1], sq[2], _MM_SHUFFLE(1,1,2,2)), _MM_SHUFFLE(2,0,2,0));
+		__m128 y = _mm_shuffle_ps(_mm_shuffle_ps(sq[0], sq[1], _MM_SHUFFLE(0,0,1,1)),
+			_mm_shuffle_ps(sq[1], sq[2], _MM_SHUFFLE(2,2,3,3)), _MM_SHUFFLE(2,0,2,0));
+		__m128 z = _mm_shuffle_ps(_mm_shuffle_ps(sq[0], sq[1], _MM_SHUFFLE(1,1,2,2)),
+			_mm_shuffle_ps(sq[2], sq[2], _MM_SHUFFLE(3,3,0,0)), _MM_SHUFFLE(2,0,2,0));
+		__m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(x, y), z));
+		__m128 clamp = _mm_cmpgt_ps(len, vMaxVel);
+		__m128 inv = _mm_div_ps(one, len);
+		// Spread the 4 per-particle values back over the interleaved layout
+		__m128 invK[3] = {
+			_mm_shuffle_ps(inv, inv, _MM_SHUFFLE(1,0,0,0)),
+			_mm_shuffle_ps(inv, inv, _MM_SHUFFLE(2,2,1,1)),
+			_mm_shuffle_ps(inv, inv, _MM_SHUFFLE(3,3,3,2))};
+		__m128 clampK[3] = {
+			_mm_shuffle_ps(clamp, clamp, _MM_SHUFFLE(1,0,0,0)),
+			_mm_shuffle_ps(clamp, clamp, _MM_SHUFFLE(2,2,1,1)),
+			_mm_shuffle_ps(clamp, clamp, _MM_SHUFFLE(3,3,3,2))};
+		for(int k = 0; k < 3; k++){
+			__m128 clamped = _mm_mul_ps(_mm_mul_ps(v[k], invK[k]), vMaxVel);
+			v[k] = _mm_or_ps(_mm_and_ps(clampK[k], clamped),
+				_mm_andnot_ps(clampK[k], v[k]));
+			__m128 p = _mm_add_ps(_mm_loadu_ps(pos + o + 4*k), _mm_mul_ps(v[k], vT));
+			_mm_storeu_ps(acc + o + 4*k, a[k]);
+			_mm_storeu_ps(vel + o + 4*k, v[k]);
+			_mm_storeu_ps(pos + o + 4*k, p);
+		}
+	}
+	integrateScalar(pos + 3*i, vel + 3*i, acc + 3*i, force + 3*i, n - i,
+		invMass, maxVel, t);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: AVX2 kernel, 8 particles (24 floats, 3 registers) per iteration.
+//		   Same steps as the SSE2 kernel; the transpose uses blends and
+//		   cross-lane permutes.
+__attribute__((target("avx2")))
+static void
+integrateAVX2(float* pos, float* vel, float* acc, const float* force,
+	size_t n, float invMass, float maxVel, float t){
+	const __m256 vInvMass = _mm256_set1_ps(invMass);
+	const __m256 vMaxVel = _mm256_set1_ps(maxVel);
+	const __m256 vT = _mm256_set1_ps(t);
+	const __m256 one = _mm256_set1_ps(1.f);
+	// Gather x, y, z lanes after blending the three registers together
+	const __m256i xIdx = _mm256_setr_epi32(0, 3, 6, 1, 4, 7, 2, 5);
+	const __m256i yIdx = _mm256_setr_epi32(1, 4, 7, 2, 5, 0, 3, 6);
+	const __m256i zIdx = _mm256_setr_epi32(2, 5, 0, 3, 6, 1, 4, 7);
+	// Spread 8 per-particle values over 24 interleaved floats
+	const __m256i spread[3] = {
+		_mm256_setr_epi32(0, 0, 0, 1, 1, 1, 2, 2),
+		_mm256_setr_epi32(2, 3, 3, 3, 4, 4, 4, 5),
+		_mm256_setr_epi32(5, 5, 6, 6, 6, 7, 7, 7)};
+	size_t i = 0;
+	for(; i + 8 <= n; i += 8){
+		size_t o = 3*i;
+		__m256 a[3], v[3], sq[3];
+		for(int k = 0; k < 3; k++){
+			a[k] = _mm256_mul_ps(_mm256_loadu_ps(force + o + 8*k), vInvMass);
+			v[k] = _mm256_add_ps(_mm256_loadu_ps(vel + o + 8*k),
+				_mm256_mul_ps(a[k], vT));
+			sq[k] = _mm256_mul_ps(v[k], v[k]);
+		}
+		__m256 x = _mm256_permutevar8x32_ps(_mm256_blend_ps(
+			_mm256_blend_ps(sq[0], sq[1], 0x92), sq[2], 0x24), xIdx);
+		__m256 y = _mm256_permutevar8x32_ps(_mm256_blend_ps(
+			_mm256_blend_ps(sq[0], sq[1], 0x24), sq[2], 0x49), yIdx);
+		__m256 z = _mm256_permutevar8x32_ps(_mm256_blend_ps(
+			_mm256_blend_ps(sq[0], sq[1], 0x49), sq[2], 0x92), zIdx);
+		__m256 len = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(x, y), z));
+		__m256 clamp = _mm256_cmp_ps(len, vMaxVel, _CMP_GT_OQ);
+		__m256 inv = _mm256_div_ps(one, len);
+		for(int k = 0; k < 3; k++){
+			__m256 clamped = _mm256_mul_ps(_mm256_mul_ps(v[k],
+				_mm256_permutevar8x32_ps(inv, spread[k])), vMaxVel);
+			v[k] = _mm256_blendv_ps(v[k], clamped,
+				_mm256_permutevar8x32_ps(clamp, spread[k]));
+			__m256 p = _mm256_add_ps(_mm256_loadu_ps(pos + o + 8*k),
+				_mm256_mul_ps(v[k], vT));
+			_mm256_storeu_ps(acc + o + 8*k, a[k]);
+			_mm256_storeu_ps(vel + o + 8*k, v[k]);
+			_mm256_storeu_ps(pos + o + 8*k, p);
+		}
+	}
+	integrateScalar(pos + 3*i, vel + 3*i, acc + 3*i, force + 3*i, n - i,
+		invMass, maxVel, t);
+}
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Pick the widest kernel the running CPU supports
+static IntegrateFunc
+selectKernel(const char** name){
+#ifdef INTEGRATOR_X86
+	__builtin_cpu_init();
+	if(__builtin_cpu_supports("avx2")){
+		*name = "avx2";
+		return integrateAVX2;
+	}
+	// SSE2 is part of every x86-64 CPU
+	if(__builtin_cpu_supports("sse2")){
+		*name = "sse2";
+		return integrateSSE2;
+	}
+#endif
+	*name = "scalar";
+	return integrateScalar;
+}
+
+static const char* kernelName = "scalar";
+static IntegrateFunc kernel = selectKernel(&kernelName);
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Advance n particles by one Euler step
+// @param pos: positions, updated
+// @param vel: velocities, updated and clamped to maxVel
+// @param acc: accelerations, overwritten with force/mass
+// @param force: cumulative force acting on each particle
+// @param n: number of particles
+// @param mass: mass of the particles
+// @param maxVel: maximum velocity of the particles
+// @param t: timestep value
+void
+integrateParticles(glm::vec3* pos, glm::vec3* vel, glm::vec3* acc,
+	const glm::vec3* force, size_t n, float mass, float maxVel, float t){
+	kernel(&pos[0].x, &vel[0].x, &acc[0].x, &force[0].x, n, 1/mass, maxVel, t);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Name of the kernel picked for this CPU
+const char*
+getIntegratorName(){
+	return kernelName;
+}
@@ -0,0 +1,16 @@
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Vectorized Euler integration for a contiguous run of particles:
+//		   force -> acceleration, velocity update, maxVel clamp and position
+//		   update. The widest kernel the CPU supports (AVX2 with 8 particles
+//		   per instruction, SSE2 with 4) is picked at runtime, with a scalar
+//		   fallback for other CPUs. Every kernel performs the same float
+//		   operations in the same order as ParticlePool::update, so all of
+//		   them produce the same result.
+#ifndef INTEGRATOR_H
+#define INTEGRATOR_H
+#include "Particle.h"
+
+void integrateParticles(glm::vec3* pos, glm::vec3* vel, glm::vec3* acc,
+	const glm::vec3* force, size_t n, float mass, float maxVel, float t);
+const char* getIntegratorName();
+#endif
@@ -1,78 +1,53 @@
 #include "Obstacle.h"
+#include "../Utilities/ConfigSchema.h"
 
 //////////////////////////////////////////////////////////////////////////////
 // @brief: Constructor
-// @param: inputFileStream a given file stream to continue reading data
-Obstacle::Obstacle(ifstream& inputFileStream){
-  while (inputFileStream.good()){
-    string input;
-    getline(inputFileStream, input);
-
-    if(input == "end")
-      break;
-    if(input == "")
-      continue;
-    else if (input[0] == '#')
-        continue;
+// @param description: corners, normal and style of the obstacle
+Obstacle::Obstacle(const ObstacleDescription& description){
+  point1 = description.point1;
+  point2 = description.point2;
+  point3 = description.point3;
+  point4 = description.point4;
+  normal = description.normal;
+  style = description.style;
+}
 
-    int i = 0;
-    vector<string> tokens;
-    tokenize(input, " ", tokens);
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Read the parameters of an obstacle, up to the line "end"
+// @param reader: reader on the line opening the obstacle's block
+void
+ObstacleDescription::read(ConfigReader& reader){
+  ConfigSchema schema;
+  schema.add("Point1", point1)
+    .add("Point2", point2)
+    .add("Point3", point3)
+    .add("Point4", point4)
+    .add("Normal", normal)
+    .add("style", style);
+  schema.readBlock(reader);
+}
 
-    if(tokens[0] == "start"){
-      do {
-        getline(inputFileStream,input);
-        tokenize(input, " ", tokens);
-        if(tokens[0] == "Point1")
-    		point1 = glm::vec3(atof(tokens[1].c_str()), atof(tokens[2].c_str()), 
-    		atof(tokens[3].c_str()));
-    	if(tokens[0] == "Point2")
-    		point2 = glm::vec3(atof(tokens[1].c_str()), atof(tokens[2].c_str()), 
-    		atof(tokens[3].c_str()));
-    	if(tokens[0] == "Point3")
-    		point3 = glm::vec3(atof(tokens[1].c_str()), atof(tokens[2].c_str()), 
-    		atof(tokens[3].c_str()));
-    	if(tokens[0] == "Point4")
-    		point4 = glm::vec3(atof(tokens[1].c_str()), atof(tokens[2].c_str()), 
-    		atof(tokens[3].c_str()));
-    	if(tokens[0] == "Normal")
-    		normal = glm::vec3(atof(tokens[1].c_str()), atof(tokens[2].c_str()), 
-    		atof(tokens[3].c_str()));
-    	if(tokens[0] == "style")
-    		style = tokens[1];
-      } while(tokens[0] != "end");
-      break;
-    }
-  }
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Whether two descriptions give the same obstacle
+bool
+ObstacleDescription::operator==(const ObstacleDescription& other) const {
+  return point1 == other.point1 && point2 == other.point2 &&
+    point3 == other.point3 && point4 == other.point4 &&
+    normal == other.normal && style == other.style;
 }
 
 //////////////////////////////////////////////////////////////////////////////
-// @brief: Parse in the obstacle input file and create obstacles accordingly
+// @brief: Parse in the obstacle input file and describe the obstacles it
+//         lists
 // @param inputFile filename of the obstacler input file
-// @param obstacles a vector of obstacles that each newly created obstacle 
-//		  should be added to.
-void Obstacle::parseInObstacles(string inputFile, vector<shared_ptr<Obstacle>>& obstacles){
-  ifstream inputFileStream;
-
-  // open file and check that it was successfully opened
-  inputFileStream.open(inputFile);
-  if (!inputFileStream.is_open()){
-   cout << "inputFile: " << inputFile << endl;
-   cerr << "Error: Unable to open file " << inputFile << endl;
-   exit(1);
-  }
-  while (inputFileStream.good()){
-    // Read each line
-    shared_ptr<Obstacle> obstacle = make_shared<Obstacle>(inputFileStream);
-    obstacles.push_back(obstacle);
-    if(inputFileStream.fail()){
-      if (inputFileStream.eof())
-        break;
-      else{
-        cerr << "Error reading data. " << endl;
-        exit(1);
-      }
-    }
+// @param obstacles a vector of obstacle descriptions that each newly read
+//		  description should be added to.
+void Obstacle::parseInObstacles(string inputFile, vector<ObstacleDescription>& obstacles){
+  ConfigReader reader(inputFile);
+  while(reader.nextBlock()){
+    obstacles.emplace_back();
+    obstacles.back().read(reader);
   }
 }
 
@@ -113,45 +88,3 @@ Obstacle::checkCollision(State oldState, State newState){
   c.n = normal;
   return c;
 }
-
-//////////////////////////////////////////////////////////////////////////////
-// @brief: Draw obstacle
-void Obstacle::draw(){
-  glColor3f(0.7,1.0,1.0);
-  if(style == "line"){
-    glLineWidth(2);
-    glBegin(GL_LINE_STRIP);
-      glVertex3f(point1.x, point1.y, point1.z);
-      glVertex3f(point2.x, point2.y, point2.z);
-      glVertex3f(point3.x, point3.y, point3.z);
-      glVertex3f(point4.x, point4.y, point4.z);
-    glEnd();
-  } else if (style == "solid"){
-    glBegin(GL_POLYGON);
-    glVertex3f(point1.x, point1.y, point1.z);
-      glVertex3f(point2.x, point2.y, point2.z);
-      glVertex3f(point3.x, point3.y, point3.z);
-      glVertex3f(point4.x, point4.y, point4.z);
-    glEnd();
-  }
-}
-
-//////////////////////////////////////////////////////////////////////////////
-// @brief: Break lines into tokens based on given identifier, then store them
-//       into given vector
-// @param input given string
-// @param split given identifier to split string by
-// @param vec vector to store the tokens into
-void Obstacle::tokenize(string input, string split, vector<string>& vec){
-  vec.clear();
-  int pos = input.find(split);
-  int currPos = 0;
-  while(pos != string::npos && currPos < input.length()){
-    vec.push_back(input.substr(currPos, pos-currPos));
-    currPos = pos + split.length();
-    pos = input.find(split, currPos);
-  }
-  if(currPos < input.length())
-    vec.push_back(input.substr(currPos));
-}
-
@@ -6,13 +6,28 @@
 #ifndef OBSTACLE_H
 #define OBSTACLE_H
 #include "Particle.h"
+#include "../Utilities/ConfigReader.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Parameters of an obstacle, as listed in an obstacles file
+struct ObstacleDescription {
+	glm::vec3 point1{0.f, 0.f, 0.f};	///< End point 1 of the rectangular plane
+	glm::vec3 point2{0.f, 0.f, 0.f};	///< End point 2 of the rectangular plane
+	glm::vec3 point3{0.f, 0.f, 0.f};	///< End point 3 of the rectangular plane
+	glm::vec3 point4{0.f, 0.f, 0.f};	///< End point 4 of the rectangular plane
+	glm::vec3 normal{0.f, 0.f, 0.f};	///< Normal vector of plane
+	string style;						///< 'invisible', 'line', or 'solid'
+
+	void read(ConfigReader& reader);
+	bool operator==(const ObstacleDescription& other) const;
+};
 
 class Obstacle {
 public:
-	Obstacle(ifstream& inputFileStream);
+	Obstacle(const ObstacleDescription& description);
 	Collision checkCollision(State oldState, State newState);
 	static void parseInObstacles(string inputFile,
-		vector<shared_ptr<Obstacle>>& obstacles);
+		vector<ObstacleDescription>& obstacles);
 	void draw();
 private:
 	glm::vec3 point1;			///< End point 1 of the rectangular plane
@@ -21,6 +36,5 @@ private:
 	glm::vec3 point4;			///< End point 4 of the rectangular plane
 	glm::vec3 normal;			///< Normal vector of plane (parallel to axis)
 	string style;				///< options: 'invisible', 'line', or 'solid'
-	void tokenize(string input, string split, vector<string>& vec);
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,24 @@
+#include "Obstacle.h"
+#include "../Utilities/GL.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Draw obstacle
+void Obstacle::draw(){
+  glColor3f(0.7,1.0,1.0);
+  if(style == "line"){
+    glLineWidth(2);
+    glBegin(GL_LINE_STRIP);
+      glVertex3f(point1.x, point1.y, point1.z);
+      glVertex3f(point2.x, point2.y, point2.z);
+      glVertex3f(point3.x, point3.y, point3.z);
+      glVertex3f(point4.x, point4.y, point4.z);
+    glEnd();
+  } else if (style == "solid"){
+    glBegin(GL_POLYGON);
+    glVertex3f(point1.x, point1.y, point1.z);
+      glVertex3f(point2.x, point2.y, point2.z);
+      glVertex3f(point3.x, point3.y, point3.z);
+      glVertex3f(point4.x, point4.y, point4.z);
+    glEnd();
+  }
+}
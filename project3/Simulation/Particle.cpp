@@ -1,117 +1,55 @@
 #include "Particle.h"
 
 //////////////////////////////////////////////////////////////////////////////
-// @brief: Constructor for particle
-// @param _pos: starting position of particle
-// @param _vel: starting velocity of particle
-// @param mass: the mass of particle
-// @param longevity: the longevity of particle
-// @param colorStart: color of particle when it's spawned
-// @param colorEnd: color of particle when it's reaching its longevity
-// @param size: size of particle
-// @param maxVel: specified max velocity particle can have
-Particle::Particle(glm::vec3 pos, glm::vec3 vel, float mass, int longevity, 
-		vector<glm::vec3> colors, float size, float maxVel,
-		float elasticity, float friction, float alphaStart, float alphaEnd){
-	state.pos = pos;
-	state.vel = vel;
-	state.acc = glm::vec3(0,0,0);
-	this->mass = mass;
-	this->longevity = longevity;
-	this->colors = colors;
-	this->size = size;
-	this->maxVel = maxVel;
-	this->elasticity = elasticity;
-	this->friction = friction;
-	this->alphaStart = alphaStart;
-	this->alphaEnd = alphaEnd;
-}
-
-//////////////////////////////////////////////////////////////////////////////
-// @brief: Draw particle
+// @brief: Bake the color transitions and alpha range into a lookup table
+//		   indexed by normalized age, so a particle's color costs one table
+//		   read when it is drawn instead of a search every update
 void
-Particle::draw(){
-	glColor4f(color.x, color.y, color.z, alpha);
-  	glVertex3f(state.pos.x, state.pos.y, state.pos.z);
-}
-
-//////////////////////////////////////////////////////////////////////////////
-// @brief: Resolve the given collision
-// @param c given collision
-void Particle::resolveCollision(Collision c){
-	// Dot equation a · b   =   a.x*b.x + a.y*b.y + a.z*b.z
-	// so for example, if c.n = (0,1,0), then c.n dot vel gives vel.z, and 
-	// vn = (0, vel.y, 0);
-	glm::vec3 vn = c.n*(glm::dot(c.n, state.vel));
-	// vt = (vel.x, 0, vel.z)
-	glm::vec3 vt = state.vel - vn;
-	// vn = (0, -vel.y * elasticity, 0)
-	// Negate y to simulate reflection off surface, with regard to the normal dir 
-	// of the surface (etc. bouncing back up for y). Elasticity is sth like 0.9, 
-	// to slow the particle down after each bouncing
-	vn *= (-elasticity);
-	// vt = (1-f)*vt, friction is small, to also simulate friction for x,z
-	vt *= (1 - friction);
-	// velNew = (velNew.x, 0, velNew.z) + (0, velNew.y, 0);
-	state.vel = vn + vt;
-
-	//TODO remove hard constant for resting distance
-	if(glm::length(state.vel) < 0.5)
-		rest = true;
-}
-
-//////////////////////////////////////////////////////////////////////////////
-// @brief: Update particle's current color based on the specified color
-// 		   transitions and the time particle has been alive
-void
-Particle::updateColor(){
-	// n colors -> (n-1) transitions
-	// For example, 1.0/3 = 1/3.
-	// 0 < x < 1/3 -> colors[0] -> colors[1]; (i*(1.0/size) < f < (i+1)*(1/size))
-    // 1/3 < x < 2/3 -> colors[1] -> colors[2] (i*(1.0/size) < f < (i+1)*(1/size))
-    // 2/3 < x < 1 -> colors[2] -> colors[3] (i*(1.0/size) < f < (i+1)*(1/size))
-    //  
-	float fractionAlive = (float)(timeAlive)/(float)longevity;
-	glm::vec3 colorStart;
-	glm::vec3 colorEnd;
-	for(int i = 0; i < colors.size() - 1; i++){
-		if(i * (1.f/(colors.size()-1)) < fractionAlive && 
-			fractionAlive <= (i+1)*(1.f/(colors.size() -1))){
-			colorStart = colors[i];
-			colorEnd = colors[i+1];
-			break;
+ParticleClass::bakeColorTable(){
+	colorTable.resize(COLOR_TABLE_SIZE);
+	for(int k = 0; k < COLOR_TABLE_SIZE; k++){
+		float fractionAlive = (float)k/(COLOR_TABLE_SIZE - 1);
+		// n colors -> (n-1) transitions
+		// For example, 1.0/3 = 1/3.
+		// 0 < x < 1/3 -> colors[0] -> colors[1]
+		// 1/3 < x < 2/3 -> colors[1] -> colors[2]
+		// 2/3 < x < 1 -> colors[2] -> colors[3]
+		glm::vec3 colorStart(1,1,1);
+		glm::vec3 colorEnd(1,1,1);
+		if(colors.size() == 1){
+			colorStart = colorEnd = colors[0];
+		} else if(colors.size() > 1){
+			float transition = 1.f/(colors.size() - 1);
+			// A newborn particle takes the first transition
+			colorStart = colors[0];
+			colorEnd = colors[1];
+			for(size_t i = 0; i < colors.size() - 1; i++){
+				if(i*transition < fractionAlive && 
+					fractionAlive <= (i+1)*transition){
+					colorStart = colors[i];
+					colorEnd = colors[i+1];
+					break;
+				}
+			}
 		}
+		glm::vec3 color = colorStart + fractionAlive*(colorEnd - colorStart);
+		float alpha = alphaStart + fractionAlive*(alphaEnd - alphaStart);
+		colorTable[k] = glm::vec4(color, alpha);
 	}
-
-	float colorX = colorStart.x + fractionAlive*(colorEnd.x - colorStart.x);
-	float colorY = colorStart.y + fractionAlive*(colorEnd.y - colorStart.y);
-	float colorZ = colorStart.z + fractionAlive*(colorEnd.z - colorStart.z);
-	alpha = alphaStart + fractionAlive*(alphaEnd - alphaStart);
-	color = glm::vec3(colorX, colorY, colorZ);
 }
 
 //////////////////////////////////////////////////////////////////////////////
-// @brief: Update particle's state with Euler's integration
-// @param force: the cumulative forces affecting the particle
-// @param s: the current state of particle
-// @param t: timestep value
-void
-Particle::update(glm::vec3 force, State s, float t){
-	timeAlive++;
-
-	updateColor();
-	
-	// Movement of particle
-	s.acc = force*(1/mass); //F = m*a meaning a = F/m
-	glm::vec3 velocity = s.vel + (s.acc*(t));
-	if(glm::length(velocity) > maxVel) {
-      glm::vec3 normalizedVel = glm::normalize(velocity);
-      velocity = (normalizedVel*(maxVel));
-    }
-	s.vel = velocity;
-	s.pos += (s.vel*(t));
-	state = s;
-	// cout << "state" << state.acc.x << " " << state.acc.y << " " << state.acc.z << endl;
-	// cout << "FinalVelocity " << state.vel.x << " " << state.vel.y << " " << state.vel.z << endl;
-	// cout << "position " << state.pos.x << " " << state.pos.y << " " << state.pos.z << endl;
-}
\ No newline at end of file
+// @brief: Look up the color and alpha of a particle of the given age
+// @param timeAlive: time particle has been alive
+// @param longevity: how long the particle "lives"
+// @return: rgb color in x, y, z and alpha in w
+glm::vec4
+ParticleClass::getColor(int timeAlive, int longevity) const{
+	float fractionAlive = (float)timeAlive/longevity;
+	int k = (int)(fractionAlive*(COLOR_TABLE_SIZE - 1) + 0.5f);
+	if(k < 0)
+		k = 0;
+	if(k > COLOR_TABLE_SIZE - 1)
+		k = COLOR_TABLE_SIZE - 1;
+	return colorTable[k];
+}
@@ -1,147 +1,154 @@
 #include "ParticleGenerator.h"
+#include "../Utilities/ConfigSchema.h"
 
 //////////////////////////////////////////////////////////////////////////////
 // @brief: Constructor
-// @param inputFileStream: stream passed in to read inputFile
+// @param description: parameters of the generator
 // @param _timeStep: value of time step
-ParticleGenerator::ParticleGenerator(ifstream& inputFileStream, float _timeStep){
-  while (inputFileStream.good()){
-    string input;
-    getline(inputFileStream, input);
-
-    if(input == "end")
-      break;
-    if(input == "")
-      continue;
-    else if (input[0] == '#')
-        continue;
-
-    int i = 0;
-    vector<string> tokens;
-    tokenize(input, " ", tokens);
-
-    if(tokens[0] == "start"){
-      do {
-        getline(inputFileStream,input);
-        tokenize(input, " ", tokens);
-        if(tokens[0] == "maxParticles")
-          maxParticles = atoi(tokens[1].c_str());
-        if(tokens[0] == "distribution")
-          distribution = tokens[1];
-        if(tokens[0] == "minimumLife")
-          minimumLife = atoi(tokens[1].c_str());
-        if(tokens[0] == "maximumLife")
-          maximumLife = atoi(tokens[1].c_str());
-        if(tokens[0] == "minNumGenerated")
-          minNumGenerated = atoi(tokens[1].c_str());
-        if(tokens[0] == "maxNumGenerated")
-          maxNumGenerated = atoi(tokens[1].c_str());
-        if(tokens[0] == "type")
-          populateTypeInfo(tokens);
-        if(tokens[0] == "timeIntervalGeneration")
-          timeIntervalGeneration = atoi(tokens[1].c_str());
-        if(tokens[0] == "elasticity")
-          elasticity = atof(tokens[1].c_str());
-        if(tokens[0] == "friction")
-          friction = atof(tokens[1].c_str());
-        if(tokens[0] == "maxVel")
-          maxVel = atof(tokens[1].c_str());
-        if(tokens[0] == "minVel")
-          minVel = atof(tokens[1].c_str());
-        if(tokens[0] == "gravity")
-          gravity = glm::vec3(atof(tokens[1].c_str()), 
-            atof(tokens[2].c_str()), atof(tokens[3].c_str()));
-        if(tokens[0] == "color"){
-          glm::vec3 color = glm::vec3(atof(tokens[1].c_str()), 
-            atof(tokens[2].c_str()), atof(tokens[3].c_str()));
-          colors.push_back(color);
-        }
-        if(tokens[0] == "size")
-          size = atof(tokens[1].c_str());
-        if(tokens[0] == "sd")
-          sd = atof(tokens[1].c_str());
-        if(tokens[0] == "forceStrength")
-          forceStrength = atof(tokens[1].c_str());
-        if(tokens[0] == "alphaStart")
-          alphaStart = atof(tokens[1].c_str());
-        if(tokens[0] == "alphaEnd")
-          alphaEnd = atof(tokens[1].c_str());
-        if(tokens[0] == "mass")
-          mass = atof(tokens[1].c_str());
-      } while(tokens[0] != "end");
-      timeStep = _timeStep;
-      currTime = timeIntervalGeneration;
-      break;
-    }
-  }
+ParticleGenerator::ParticleGenerator(const GeneratorDescription& description,
+  float _timeStep){
+  type = description.type;
+  point = description.point;
+  line = description.line;
+  circle = description.circle;
+  distribution = description.distribution;
+  maxParticles = description.maxParticles;
+  minimumLife = description.minimumLife;
+  maximumLife = description.maximumLife;
+  minNumGenerated = description.minNumGenerated;
+  maxNumGenerated = description.maxNumGenerated;
+  timeIntervalGeneration = description.timeIntervalGeneration;
+  minVel = description.minVel;
+  gravity = description.gravity;
+  sd = description.sd;
+  forceStrength = description.forceStrength;
+
+  timeStep = _timeStep;
+  currTime = timeIntervalGeneration;
+  ParticleClass attributes = description.attributes;
+  attributes.bakeColorTable();
+  particleClass = make_shared<const ParticleClass>(attributes);
+  particles.setClass(particleClass);
+  // A generation can overshoot maxParticles by at most maxNumGenerated
+  particles.reserve(maxParticles + maxNumGenerated + 1, maximumLife);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Read the parameters of a generator, up to the line "end"
+// @param reader: reader on the line opening the generator's block
+void
+GeneratorDescription::read(ConfigReader& reader){
+  ConfigSchema schema;
+  schema.add("maxParticles", maxParticles)
+    .add("distribution", distribution)
+    .add("minimumLife", minimumLife)
+    .add("maximumLife", maximumLife)
+    .add("minNumGenerated", minNumGenerated)
+    .add("maxNumGenerated", maxNumGenerated)
+    .add("type", [this](ConfigReader& line){ readType(line); })
+    .add("timeIntervalGeneration", timeIntervalGeneration)
+    .add("elasticity", attributes.elasticity)
+    .add("friction", attributes.friction)
+    .add("maxVel", attributes.maxVel)
+    .add("minVel", minVel)
+    .add("gravity", gravity)
+    .add("color", [this](ConfigReader& line){
+      line.expectValues(3);
+      attributes.colors.push_back(line.getVec3(0));
+    })
+    .add("size", attributes.size)
+    .add("sd", sd)
+    .add("forceStrength", forceStrength)
+    .add("alphaStart", attributes.alphaStart)
+    .add("alphaEnd", attributes.alphaEnd)
+    .add("mass", attributes.mass);
+  schema.readBlock(reader);
 }
 
 //////////////////////////////////////////////////////////////////////////////
-// @brief: Populate information about the generator type
-// @param tokens: the line containing information about the generator type, 
-//         broken into tokens
+// @brief: Read the generator type
+// @param reader: reader on the line giving the generator type, e.g.
+//        type Circle center <x> <y> <z> radius <r> normal <x> <y> <z>
 void
-ParticleGenerator::populateTypeInfo(vector<string>& tokens){
-  string typeName = tokens[1];
+GeneratorDescription::readType(ConfigReader& reader){
+  string_view typeName = reader.getValue(0);
   if(typeName == "Point"){
+    reader.expectValues(5);
     type = PointType;
-    point.pos = glm::vec3(atof(tokens[3].c_str()), atof(tokens[4].c_str()), 
-      atof(tokens[5].c_str()));
+    point.pos = reader.getVec3(2);
   } else if (typeName == "Line"){
+    reader.expectValues(13);
     type = LineType;
-    line.endPoint1 = glm::vec3(atof(tokens[3].c_str()), 
-      atof(tokens[4].c_str()), atof(tokens[5].c_str()));
-    line.endPoint2 = glm::vec3(atof(tokens[7].c_str()),
-      atof(tokens[8].c_str()), atof(tokens[9].c_str()));
-    line.normal = glm::vec3(atof(tokens[11].c_str()), 
-      atof(tokens[12].c_str()), atof(tokens[13].c_str()));
-  } else if (typeName == "Circle"){
-    type = CircleType;
-    circle.center = glm::vec3(atof(tokens[3].c_str()), 
-      atof(tokens[4].c_str()), atof(tokens[5].c_str()));
-    circle.radius = atof(tokens[7].c_str());
-    circle.normal = glm::vec3(atof(tokens[9].c_str()), 
-      atof(tokens[10].c_str()), atof(tokens[11].c_str()));
-  } else if (typeName == "Beam"){
-    type = BeamType;
-    circle.center = glm::vec3(atof(tokens[3].c_str()), 
-      atof(tokens[4].c_str()), atof(tokens[5].c_str()));
-    circle.radius = atof(tokens[7].c_str());
-    circle.normal = glm::vec3(atof(tokens[9].c_str()), 
-      atof(tokens[10].c_str()), atof(tokens[11].c_str()));
-  } else if (typeName == "Fire"){
-    type = FireType;
-    circle.center = glm::vec3(atof(tokens[3].c_str()), 
-      atof(tokens[4].c_str()), atof(tokens[5].c_str()));
-    circle.radius = atof(tokens[7].c_str());
-    circle.normal = glm::vec3(atof(tokens[9].c_str()), 
-      atof(tokens[10].c_str()), atof(tokens[11].c_str()));
-  } 
+    line.endPoint1 = reader.getVec3(2);
+    line.endPoint2 = reader.getVec3(6);
+    line.normal = reader.getVec3(10);
+  } else if (typeName == "Circle" || typeName == "Beam" || typeName == "Fire"){
+    reader.expectValues(11);
+    type = typeName == "Circle" ? CircleType :
+      typeName == "Beam" ? BeamType : FireType;
+    circle.center = reader.getVec3(2);
+    circle.radius = reader.getFloat(6);
+    circle.normal = reader.getVec3(8);
+  } else
+    reader.error("unknown generator type '" + string(typeName) + "'");
 }
 
 //////////////////////////////////////////////////////////////////////////////
-// @brief: Generate forces affecting the particles
-// @return: the cumulative force of all the forces affecting the particles
+// @brief: Whether two descriptions give the same generator
+bool
+GeneratorDescription::operator==(const GeneratorDescription& other) const {
+  const ParticleClass& a = attributes;
+  const ParticleClass& b = other.attributes;
+  return type == other.type && point.pos == other.point.pos &&
+    point.normal == other.point.normal &&
+    line.endPoint1 == other.line.endPoint1 &&
+    line.endPoint2 == other.line.endPoint2 &&
+    line.normal == other.line.normal &&
+    circle.center == other.circle.center &&
+    circle.radius == other.circle.radius &&
+    circle.normal == other.circle.normal &&
+    distribution == other.distribution &&
+    maxParticles == other.maxParticles && minimumLife == other.minimumLife &&
+    maximumLife == other.maximumLife &&
+    minNumGenerated == other.minNumGenerated &&
+    maxNumGenerated == other.maxNumGenerated &&
+    timeIntervalGeneration == other.timeIntervalGeneration &&
+    minVel == other.minVel && gravity == other.gravity && sd == other.sd &&
+    forceStrength == other.forceStrength && a.mass == b.mass &&
+    a.size == b.size && a.maxVel == b.maxVel &&
+    a.elasticity == b.elasticity && a.friction == b.friction &&
+    a.alphaStart == b.alphaStart && a.alphaEnd == b.alphaEnd &&
+    a.colors == b.colors;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Generate forces affecting a batch of particles
+// @param begin: index of the first particle
+// @param n: number of particles
+// @param forces: set to the cumulative force of all the generator's forces
+//        affecting each particle
 // @TODO: Change all those arbitrary constant
-glm::vec3
-ParticleGenerator::generateForces(shared_ptr<Particle> particle){
+void
+ParticleGenerator::generateForces(size_t begin, size_t n, glm::vec3* forces){
   glm::vec3 f(0,0,0);
-  f += gravity*(mass);
-  if(type == FireType)
-    f += fireForce(particle);
-
-  return(f);
+  f += gravity*(particleClass->mass);
+  for(size_t k = 0; k < n; k++)
+    forces[k] = f;
+  if(type == FireType){
+    for(size_t k = 0; k < n; k++)
+      forces[k] += fireForce(begin + k);
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////////
 // @brief: Generate force for fire particles to keep them around the center 
 //         normal axis
-// @param particle the given paritcle
+// @param i index of the given particle
 glm::vec3 
-ParticleGenerator::fireForce(shared_ptr<Particle> particle){
+ParticleGenerator::fireForce(size_t i){
   glm::vec3 force = glm::vec3(0,0,0);
-  glm::vec3 pos = particle->getCurrentState().pos;
-  glm::vec3 vel = particle->getCurrentState().vel;
+  glm::vec3 pos = particles.getPosition(i);
+  glm::vec3 vel = particles.getVelocity(i);
     // vec's component will be positive if circle.normal component is negative
   glm::vec3 vec = circle.normal*(glm::dot(circle.normal, glm::vec3(1,1,1)));
     // Thus in here circle.normal*(glm::dot(vec, pos)) would retain the sign of
@@ -158,7 +165,7 @@ ParticleGenerator::fireForce(shared_ptr<Particle> particle){
   glm::vec3 componentVel = vel - circle.normal*(glm::dot(vec, vel));
   // Find the angle between them to find if particle is heading outside the 
   // fire's center
-  float ratio = (float)(particle->getTimeAlive())/ particle->getLongevity();
+  float ratio = (float)(particles.getTimeAlive(i))/ particles.getLongevity(i);
   ratio = forceStrength*ratio;
   force += dir*(ratio);
   return force;
@@ -166,37 +173,17 @@ ParticleGenerator::fireForce(shared_ptr<Particle> particle){
 }
 
 //////////////////////////////////////////////////////////////////////////////
-// @brief: Parse in the generator input file and create particle generatos
-//         accordingly
+// @brief: Parse in the generator input file and describe the particle
+//         generators it lists
 // @param inputFile filename of the generator input file
-// @param generators a vector of particle generators that each newly created
-//        particle generator should be added to.
-// @param _timeStep: user-specified value for the time step
+// @param generators a vector of generator descriptions that each newly read
+//        description should be added to.
 void ParticleGenerator::parseInGenerators(string inputFile, 
-  vector<shared_ptr<ParticleGenerator>>& generators, float _timeStep){
-  // declare an input-file stream variable for reading
-  ifstream inputFileStream;
-
- // open file and check that it was successfully opened
-  inputFileStream.open(inputFile);
-  if (!inputFileStream.is_open()){
-   cout << "inputFile: " << inputFile << endl;
-   cerr << "Error: Unable to open file " << inputFile << endl;
-   exit(1);
-  }
-  while (inputFileStream.good()){
-    // Read each line
-    shared_ptr<ParticleGenerator> generator = 
-      make_shared<ParticleGenerator>(inputFileStream, _timeStep);
-    generators.push_back(generator);
-    if(inputFileStream.fail()){
-      if (inputFileStream.eof())
-        break;
-      else{
-        cerr << "Error reading data. " << endl;
-        exit(1);
-      }
-    }
+  vector<GeneratorDescription>& generators){
+  ConfigReader reader(inputFile);
+  while(reader.nextBlock()){
+    generators.emplace_back();
+    generators.back().read(reader);
   }
 }
 
@@ -206,12 +193,12 @@ void ParticleGenerator::parseInGenerators(string inputFile,
 //         the user-specified max number of particles for this generator
 void
 ParticleGenerator::generateParticles(){
+  ProfileScope scope("emit", generatorId);
   if(particles.size() > maxParticles){
     return;
   }
   if(currTime-- == 0){
     currTime = timeIntervalGeneration;
-    shared_ptr<Particle> particle;
     if(distribution == "uniform"){
       switch(type){
         case PointType:
@@ -235,56 +222,56 @@ ParticleGenerator::generateParticles(){
 }
 
 //////////////////////////////////////////////////////////////////////////////
-// @brief: Draw all particles owned by the generator
-void ParticleGenerator::draw(){
-  glPointSize(size);
-  glBegin(GL_POINTS);
-  for(auto& particle : particles){
-    particle->draw();
-  }
-  glEnd();
+// @brief: Set the seed of the generator's random streams
+// @param seed: seed shared by every generator of the scene
+// @param id: index of the generator, so generators draw different streams
+void
+ParticleGenerator::seedRandom(uint64_t seed, uint32_t id){
+  randomSeed = seed;
+  generatorId = id;
 }
 
 //////////////////////////////////////////////////////////////////////////////
-// @brief: Break lines into tokens based on given identifier, then store them
-//       into given vector
-// @param input given string
-// @param split given identifier to split string by
-// @param vec vector to store the tokens into
-void ParticleGenerator::tokenize(string input, string split, vector<string>& vec){
-  vec.clear();
-  int pos = input.find(split);
-  int currPos = 0;
-  while(pos != string::npos && currPos < input.length()){
-    vec.push_back(input.substr(currPos, pos-currPos));
-    currPos = pos + split.length();
-    pos = input.find(split, currPos);
-  }
-  if(currPos < input.length())
-    vec.push_back(input.substr(currPos));
+// @brief: Random stream for the current frame. Every (seed, frame,
+//         generator) triple has its own stream, so the particles spawned
+//         do not depend on the order generators run in.
+Philox
+ParticleGenerator::randomStream(){
+  return Philox(randomSeed, particles.getFrame(), generatorId);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Size the sample buffers for a generation
+// @param numGenerated: number of particles generated
+// @param numSamples: number of random floats needed per particle
+// @return: the float buffer, numSamples*numGenerated long
+float*
+ParticleGenerator::sampleBuffers(int numGenerated, int numSamples){
+  samples.resize(numSamples*numGenerated);
+  lifetimes.resize(numGenerated);
+  return samples.data();
 }
 
 //////////////////////////////////////////////////////////////////////////////
 // @brief: Generate particles based on a uniform distribution, from a point. 
 //         All particles share same spawning position, just with different velocities
 void ParticleGenerator::pointGenerate(float sd){
+  float maxVel = particleClass->maxVel;
   glm::vec3 position;
   glm::vec3 velocity;
-  unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-  std::default_random_engine generator (seed);
-  std::uniform_int_distribution<int> distributionNumParticles(minNumGenerated, 
-    maxNumGenerated);
-  int numGenerated = distributionNumParticles(generator);
-  std::uniform_int_distribution<int> distributionLongevity(minimumLife, 
-    maximumLife);
+  Philox generator = randomStream();
+  int numGenerated = generator.uniformInt(minNumGenerated, maxNumGenerated);
+  if(numGenerated <= 0)
+    return;
+  float* velocities = sampleBuffers(numGenerated, 3);
   // @TODO: Remove hard code variables
-  std::uniform_real_distribution<double> distributionReal(-3, 3);
+  generator.uniform(velocities, 3*numGenerated, -3, 3);
+  generator.uniformInt(lifetimes.data(), numGenerated, minimumLife, maximumLife);
 
   for(int i = 0; i < numGenerated; i++){
     position = glm::vec3(point.pos.x, point.pos.y, point.pos.z);
-    velocity = glm::vec3(distributionReal(generator),
-      distributionReal(generator), distributionReal(generator));
-    int longevity = distributionLongevity(generator);
+    velocity = glm::vec3(velocities[3*i], velocities[3*i+1], velocities[3*i+2]);
+    int longevity = lifetimes[i];
 
     // Cap velocity at the user-specifed maxVel
     if(glm::length(velocity) > maxVel) {
@@ -292,10 +279,7 @@ void ParticleGenerator::pointGenerate(float sd){
       velocity = (normalizedVel*(maxVel));
     }
 
-    shared_ptr<Particle> particle = make_shared<Particle>(position, velocity,
-      mass, longevity, colors, size, maxVel, elasticity, friction,
-      alphaStart, alphaEnd);
-    particles.push_back(particle);
+    particles.add(position, velocity, longevity);
   }
 }
 
@@ -306,23 +290,25 @@ void ParticleGenerator::pointGenerate(float sd){
 //         small standard deviation, and the mean corresponds to the specified
 //         normal vector
 void ParticleGenerator::lineGenerate(){
+  float maxVel = particleClass->maxVel;
   glm::vec3 position;
   glm::vec3 velocity;
   float length = glm::length(line.endPoint2 - line.endPoint1);
-  unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-  std::default_random_engine generator (seed);
-  std::uniform_int_distribution<int> distributionNumParticles(minNumGenerated, maxNumGenerated);
-  std::uniform_int_distribution<int> distributionLongevity(minimumLife, maximumLife);
-  std::uniform_real_distribution<double> distributionVelScale(minVel, maxVel*3);
-  std::uniform_real_distribution<double> distributionLength(0.0, length);
-  std::normal_distribution<float> distributionVelDirX(line.normal.x,0.05);
-  std::normal_distribution<float> distributionVelDirY(line.normal.x,0.05);
-  std::normal_distribution<float> distributionVelDirZ(line.normal.x,0.05);
-
-  int numGenerated = distributionNumParticles(generator);
+  Philox generator = randomStream();
+  int numGenerated = generator.uniformInt(minNumGenerated, maxNumGenerated);
+  if(numGenerated <= 0)
+    return;
+  float* lengths = sampleBuffers(numGenerated, 7);
+  float* velDirs = lengths + numGenerated;
+  float* velScales = velDirs + 3*numGenerated;
+  generator.uniform(lengths, numGenerated, 0.0, length);
+  generator.normal(velDirs, 3*numGenerated, line.normal.x, 0.05);
+  generator.uniform(velScales, 3*numGenerated, minVel, maxVel*3);
+  generator.uniformInt(lifetimes.data(), numGenerated, minimumLife, maximumLife);
+
   for(int i = 0; i < numGenerated; i++){
     // Randomize the value of the distance away from Point1
-    float randLength = distributionLength(generator);
+    float randLength = lengths[i];
     glm::vec3 dir = line.endPoint2 - line.endPoint1;
     dir = glm::normalize(dir);
     position = line.endPoint1 + randLength * dir;
@@ -331,12 +317,11 @@ void ParticleGenerator::lineGenerate(){
     // corresponding to the normal vector of the line (or the general direction
     // most particles will travel). The magnitude of the velocity is also
     // randomized
-    glm::vec3 dirVel = glm::vec3(distributionVelDirX(generator),
-      distributionVelDirY(generator),distributionVelDirZ(generator));
+    glm::vec3 dirVel = glm::vec3(velDirs[3*i], velDirs[3*i+1], velDirs[3*i+2]);
     dirVel = glm::normalize(dirVel);
-    velocity = glm::vec3(distributionVelScale(generator) * dirVel.x,
-      distributionVelScale(generator) * dirVel.y, distributionVelScale(generator)*dirVel.z);
-    int longevity = distributionLongevity(generator);
+    velocity = glm::vec3(velScales[3*i] * dirVel.x,
+      velScales[3*i+1] * dirVel.y, velScales[3*i+2]*dirVel.z);
+    int longevity = lifetimes[i];
 
     // Cap velocity at the user-specifed maxVel
     if(glm::length(velocity) > maxVel) {
@@ -344,10 +329,7 @@ void ParticleGenerator::lineGenerate(){
       velocity = (normalizedVel*(maxVel));
     }
 
-    shared_ptr<Particle> particle = make_shared<Particle>(position, velocity,
-      mass, longevity, colors, size, maxVel, elasticity, friction,
-      alphaStart, alphaEnd);
-    particles.push_back(particle);
+    particles.add(position, velocity, longevity);
   }
 }
 
@@ -356,24 +338,27 @@ void ParticleGenerator::lineGenerate(){
 //         Randomize positions by varying angle of circle and vector from center to
 //         position. Randomize velocities but keep the same normal component.
 void ParticleGenerator::circleGenerate(float sd){
+  float maxVel = particleClass->maxVel;
   glm::vec3 position;
   glm::vec3 velocity;
 
-  unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-  std::default_random_engine generator (seed);
-  std::uniform_int_distribution<int> distributionNumParticles(minNumGenerated, maxNumGenerated);
-  std::uniform_int_distribution<int> distributionLongevity(minimumLife, maximumLife);
-  std::uniform_real_distribution<float> distributionVelScale(0.0, maxVel);
-  std::uniform_real_distribution<float> distributionLength(0.0, circle.radius);
-  std::normal_distribution<float> distributionVelDirX(circle.normal.x, sd);
-  std::normal_distribution<float> distributionVelDirY(circle.normal.x, sd);
-  std::normal_distribution<float> distributionVelDirZ(circle.normal.x, sd);
-  std::uniform_real_distribution<float> distributionAngle(0.0, 360.0);
-
-  int numGenerated = distributionNumParticles(generator);
+  Philox generator = randomStream();
+  int numGenerated = generator.uniformInt(minNumGenerated, maxNumGenerated);
+  if(numGenerated <= 0)
+    return;
+  float* angles = sampleBuffers(numGenerated, 9);
+  float* lengths = angles + numGenerated;
+  float* velDirs = lengths + numGenerated;
+  float* velScales = velDirs + 3*numGenerated;
+  generator.uniform(angles, numGenerated, 0.0, 360.0);
+  generator.uniform(lengths, numGenerated, 0.0, circle.radius);
+  generator.normal(velDirs, 3*numGenerated, circle.normal.x, sd);
+  generator.uniform(velScales, 4*numGenerated, 0.0, maxVel);
+  generator.uniformInt(lifetimes.data(), numGenerated, minimumLife, maximumLife);
+
   for(int i = 0; i < numGenerated; i++){
-    float angle = distributionAngle(generator);
-    float randLength = distributionLength(generator);
+    float angle = angles[i];
+    float randLength = lengths[i];
 
     // Get a vector with 1's in the non-normal direction
     glm::vec3 vRandom = glm::vec3(1,1,1) - 
@@ -385,18 +370,17 @@ void ParticleGenerator::circleGenerate(float sd){
     vRandom = glm::normalize(glm::rotate(vRandom, angle, circle.normal));
     position = circle.center + vRandom*(randLength);
     
-    glm::vec3 dirVel = glm::vec3(distributionVelDirX(generator),
-      distributionVelDirY(generator),distributionVelDirZ(generator));
+    glm::vec3 dirVel = glm::vec3(velDirs[3*i], velDirs[3*i+1], velDirs[3*i+2]);
     dirVel = glm::normalize(dirVel);
-    velocity = glm::vec3(distributionVelScale(generator) * dirVel.x,
-      distributionVelScale(generator) * dirVel.y, distributionVelScale(generator)*dirVel.z);
+    velocity = glm::vec3(velScales[4*i] * dirVel.x,
+      velScales[4*i+1] * dirVel.y, velScales[4*i+2]*dirVel.z);
 
     // Whichever directional component of velocity parallels to the normal vector
     // will be only going in the normal direction
     velocity = velocity - circle.normal*(glm::dot(circle.normal, velocity));
-    velocity = velocity + circle.normal*distributionVelScale(generator);
+    velocity = velocity + circle.normal*velScales[4*i+3];
 
-    int longevity = distributionLongevity(generator);
+    int longevity = lifetimes[i];
 
     // Cap velocity at the user-specifed maxVel
     if(glm::length(velocity) > maxVel) {
@@ -404,10 +388,7 @@ void ParticleGenerator::circleGenerate(float sd){
       velocity = (normalizedVel*(maxVel));
     }
 
-    shared_ptr<Particle> particle = make_shared<Particle>(position, velocity,
-      mass, longevity, colors, size, maxVel, elasticity, friction,
-      alphaStart, alphaEnd);
-    particles.push_back(particle);
+    particles.add(position, velocity, longevity);
   }
 }
 
@@ -416,24 +397,27 @@ void ParticleGenerator::circleGenerate(float sd){
 //         Randomize positions by varying angle of circle and vector from center to
 //         position. Velocities are set equal to the normal.
 void ParticleGenerator::fireGenerate(float sd){
+  float maxVel = particleClass->maxVel;
   glm::vec3 position;
   glm::vec3 velocity;
 
-  unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-  std::default_random_engine generator (seed);
-  std::uniform_int_distribution<int> distributionNumParticles(minNumGenerated, maxNumGenerated);
-  std::uniform_int_distribution<int> distributionLongevity(minimumLife, maximumLife);
-  std::uniform_real_distribution<float> distributionVelScale(minVel, maxVel);
-  std::uniform_real_distribution<float> distributionLength(0.0, circle.radius);
-  std::uniform_real_distribution<float> distributionAngle(0.0, 360.0);
-  std::normal_distribution<float> distributionVelDirX(circle.normal.x, sd);
-  std::normal_distribution<float> distributionVelDirY(circle.normal.x, sd);
-  std::normal_distribution<float> distributionVelDirZ(circle.normal.x, sd);
-
-  int numGenerated = distributionNumParticles(generator);
+  Philox generator = randomStream();
+  int numGenerated = generator.uniformInt(minNumGenerated, maxNumGenerated);
+  if(numGenerated <= 0)
+    return;
+  float* angles = sampleBuffers(numGenerated, 9);
+  float* lengths = angles + numGenerated;
+  float* velDirs = lengths + numGenerated;
+  float* velScales = velDirs + 3*numGenerated;
+  generator.uniform(angles, numGenerated, 0.0, 360.0);
+  generator.uniform(lengths, numGenerated, 0.0, circle.radius);
+  generator.normal(velDirs, 3*numGenerated, circle.normal.x, sd);
+  generator.uniform(velScales, 4*numGenerated, minVel, maxVel);
+  generator.uniformInt(lifetimes.data(), numGenerated, minimumLife, maximumLife);
+
   for(int i = 0; i < numGenerated; i++){
-    float angle = distributionAngle(generator);
-    float randLength = distributionLength(generator);
+    float angle = angles[i];
+    float randLength = lengths[i];
 
     // Get a vector with 1's in the non-normal direction
     glm::vec3 vRandom = glm::vec3(1,1,1) - 
@@ -445,15 +429,14 @@ void ParticleGenerator::fireGenerate(float sd){
     vRandom = glm::normalize(glm::rotate(vRandom, angle, circle.normal));
     position = circle.center + vRandom*(randLength);
     
-    glm::vec3 dirVel = glm::vec3(distributionVelDirX(generator),
-      distributionVelDirY(generator),distributionVelDirZ(generator));
-    velocity = glm::vec3(distributionVelScale(generator) * dirVel.x,
-      distributionVelScale(generator) * dirVel.y, distributionVelScale(generator)*dirVel.z);
+    glm::vec3 dirVel = glm::vec3(velDirs[3*i], velDirs[3*i+1], velDirs[3*i+2]);
+    velocity = glm::vec3(velScales[4*i] * dirVel.x,
+      velScales[4*i+1] * dirVel.y, velScales[4*i+2]*dirVel.z);
     // Whichever directional component of velocity parallels to the normal vector
     // will be only going in the normal direction
     velocity = velocity - circle.normal*(glm::dot(circle.normal, velocity));
-    velocity = velocity + circle.normal*distributionVelScale(generator);
-    int longevity = distributionLongevity(generator);
+    velocity = velocity + circle.normal*velScales[4*i+3];
+    int longevity = lifetimes[i];
 
     // Cap velocity at the user-specifed maxVel
     if(glm::length(velocity) > maxVel) {
@@ -461,10 +444,7 @@ void ParticleGenerator::fireGenerate(float sd){
       velocity = (normalizedVel*(maxVel));
     }
 
-    shared_ptr<Particle> particle = make_shared<Particle>(position, velocity,
-      mass, longevity, colors, size, maxVel, elasticity, friction,
-      alphaStart, alphaEnd);
-    particles.push_back(particle);
+    particles.add(position, velocity, longevity);
   }
 }
 
@@ -473,21 +453,25 @@ void ParticleGenerator::fireGenerate(float sd){
 //         Randomize positions by varying angle of circle and vector from center to
 //         position. Velocities are set equal to the normal.
 void ParticleGenerator::beamGenerate(){
+  float maxVel = particleClass->maxVel;
   glm::vec3 position;
   glm::vec3 velocity;
 
-  unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-  std::default_random_engine generator (seed);
-  std::uniform_int_distribution<int> distributionNumParticles(minNumGenerated, maxNumGenerated);
-  std::uniform_int_distribution<int> distributionLongevity(minimumLife, maximumLife);
-  std::uniform_real_distribution<float> distributionVelScale(minVel, maxVel);
-  std::uniform_real_distribution<float> distributionLength(0.0, circle.radius);
-  std::uniform_real_distribution<float> distributionAngle(0.0, 360.0);
+  Philox generator = randomStream();
+  int numGenerated = generator.uniformInt(minNumGenerated, maxNumGenerated);
+  if(numGenerated <= 0)
+    return;
+  float* angles = sampleBuffers(numGenerated, 3);
+  float* lengths = angles + numGenerated;
+  float* velScales = lengths + numGenerated;
+  generator.uniform(angles, numGenerated, 0.0, 360.0);
+  generator.uniform(lengths, numGenerated, 0.0, circle.radius);
+  generator.uniform(velScales, numGenerated, minVel, maxVel);
+  generator.uniformInt(lifetimes.data(), numGenerated, minimumLife, maximumLife);
 
-  int numGenerated = distributionNumParticles(generator);
   for(int i = 0; i < numGenerated; i++){
-    float angle = distributionAngle(generator);
-    float randLength = distributionLength(generator);
+    float angle = angles[i];
+    float randLength = lengths[i];
 
     // Get a vector with 1's in the non-normal direction
     glm::vec3 vRandom = glm::vec3(1,1,1) - 
@@ -499,8 +483,8 @@ void ParticleGenerator::beamGenerate(){
     vRandom = glm::normalize(glm::rotate(vRandom, angle, circle.normal));
     position = circle.center + vRandom*(randLength);
     
-    velocity = circle.normal*(distributionVelScale(generator));
-    int longevity = distributionLongevity(generator);
+    velocity = circle.normal*(velScales[i]);
+    int longevity = lifetimes[i];
 
     // Cap velocity at the user-specifed maxVel
     if(glm::length(velocity) > maxVel) {
@@ -508,9 +492,6 @@ void ParticleGenerator::beamGenerate(){
       velocity = (normalizedVel*(maxVel));
     }
 
-    shared_ptr<Particle> particle = make_shared<Particle>(position, velocity,
-      mass, longevity, colors, size, maxVel, elasticity, friction,
-      alphaStart, alphaEnd);
-    particles.push_back(particle);
+    particles.add(position, velocity, longevity);
   }
 }
\ No newline at end of file
@@ -3,7 +3,11 @@
 //		   at randomized positions and randomized initial velocities
 #ifndef PARTICLEGENERATOR_H
 #define PARTICLEGENERATOR_H
-#include "Particle.h"
+#include "ParticlePool.h"
+#include "../Utilities/Philox.h"
+#include "../Utilities/Profiler.h"
+#include "../Utilities/ConfigReader.h"
+class StreamBuffer;
 enum GeneratorType {PointType, LineType, CircleType, BeamType, FireType};
 
 //////////////////////////////////////////////////////////////////////////////
@@ -34,21 +38,54 @@ struct Circle{
 	glm::vec3 normal;
 };
 
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Parameters of a particle generator, as listed in a generators file
+struct GeneratorDescription {
+	GeneratorType type{PointType};	//< Type of generator
+	Point point{};					//< Point generator
+	Line line{};					//< Line generator
+	Circle circle{};				//< Circle generator
+	string distribution;			//< "normal" or "uniform"
+	int maxParticles{0};			//< Maximum number of particles
+	int minimumLife{0};				//< Minimum longevity of particles
+	int maximumLife{0};				//< Maximum longevity of particles
+	int minNumGenerated{0};			//< Minimum particles per generation
+	int maxNumGenerated{0};			//< Maximum particles per generation
+	int timeIntervalGeneration{0};	//< Time in between generations
+	float minVel{0.f};				//< Min velocity
+	glm::vec3 gravity{0.f, 0.f, 0.f};	//< Gravity force
+	float sd{0.5f};					//< Standard deviation
+	float forceStrength{0.f};		//< Needed for fire generator
+	ParticleClass attributes{};		//< Attributes of the particles, colors
+									//< not baked
+
+	void read(ConfigReader& reader);
+	bool operator==(const GeneratorDescription& other) const;
+private:
+	void readType(ConfigReader& reader);
+};
+
 class ParticleGenerator {
 public:
 	
-	ParticleGenerator(ifstream& inputFileStream, float timeStep);
+	ParticleGenerator(const GeneratorDescription& description, float timeStep);
 	static void parseInGenerators(string inputFile,
-		vector<shared_ptr<ParticleGenerator>>& generators, float timeStep);
+		vector<GeneratorDescription>& generators);
 	void generateParticles();
 	void draw();
-	glm::vec3 generateForces(shared_ptr<Particle> particle);
-	vector<shared_ptr<Particle>>& getParticles() { return particles; }
-	float getSize() { return size; }
+	void generateForces(size_t begin, size_t n, glm::vec3* forces);
+	void seedRandom(uint64_t seed, uint32_t id);
+	ParticlePool& getParticles() { return particles; }
+	int getId() { return generatorId; }
+	float getSize() { return particleClass->size; }
+	static void setStreamDrawing(bool enabled) { streamDrawing = enabled; }
+	static bool isStreamDrawing();
 
 private:
 	int maxParticles;		   //< Maximum number of particles in system
-	vector<shared_ptr<Particle>> particles;	  //< List of particles in the system
+	ParticlePool particles;	   		//< Particles in the system
+	shared_ptr<const ParticleClass> particleClass;	//< Attributes shared by
+													//< all particles
 	string distribution;	   		//< Can have 2 values: "normal" or "uniform"
 	// To create variance in randomly generated particles, some particle attributes
 	// have a random value in between a specified min and max time values
@@ -60,20 +97,20 @@ private:
 							   		//< time generateParticles() is called
 	int timeIntervalGeneration;		//< Time in between generations
 	int currTime;		  			//< Current time in system
-	float elasticity; 		   		//< Elasticity constant
-	float friction;   		   		//< Friction constant
-	float maxVel;			   		//< Max velocity
 	float minVel;			   		//< Min velocity
 	glm::vec3 gravity;		   		//< Gravity force
-	vector<glm::vec3> colors;	 	//< Color stages of particle
-	float size;						//< size of particles
-	float mass;						//< mass of particles
 	float timeStep;					//< timeStep value
-	float alphaStart;				//< starting alpha value of particle
-	float alphaEnd;					//< ending alpha value of particle
 	float sd {0.5};					//< Standard deviation (for some generator this
 									//< variable is needed)
 	float forceStrength;			//< Needed for fire generator
+	uint64_t randomSeed{0};			//< Seed of the random streams
+	uint32_t generatorId{0};		//< Index of the generator in the scene
+	vector<float> samples;			//< Random floats of a generation
+	vector<int> lifetimes;			//< Random longevities of a generation
+	shared_ptr<StreamBuffer> vertexBuffer;	//< Particle vertices streamed to
+											//< the GPU, made on first draw
+	static bool streamDrawing;		//< Draw from vertexBuffer rather than in
+									//< immediate mode, where supported
 	////////////////////////////////////////////////////////////////////////////
 	// Generator type
 	GeneratorType type;		   		//< Type of generator
@@ -91,16 +128,12 @@ private:
 	void fireGenerate(float sd);	//< Generate particles in uniform distribution
 									//< with  beamGenerator
 	//< Generate force for fire particles
-	glm::vec3 fireForce(shared_ptr<Particle> particle);
-
-	////////////////////////////////////////////////////////////////////////////
-	// Helper methods
-	void tokenize(string input, string split, vector<string>& vec);
-	void populateTypeInfo(vector<string>& tokens);
+	glm::vec3 fireForce(size_t i);
+	Philox randomStream();
+	float* sampleBuffers(int numGenerated, int numSamples);
+	bool drawStreamed();
+	void drawImmediate();
 };
 
 
-#if   defined(OSX)
-#pragma clang diagnostic pop
-#endif
 #endif
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "ParticleGenerator.h"
+#include "../Utilities/GL.h"
+#include "../Utilities/StreamBuffer.h"
+
+bool ParticleGenerator::streamDrawing = true;
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Vertex of a streamed particle, 16 bytes
+struct ParticleVertex {
+  glm::vec3 pos;
+  GLubyte color[4];
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Whether particles are drawn from vertex buffers. Needs a current
+//         GL context to check for support.
+bool ParticleGenerator::isStreamDrawing(){
+  return streamDrawing && glHasBufferObjects();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Draw all particles owned by the generator
+void ParticleGenerator::draw(){
+  glPointSize(particleClass->size);
+  if(particles.size() == 0)
+    return;
+  if(!isStreamDrawing() || !drawStreamed())
+    drawImmediate();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Pack the particles into the next vertex buffer and draw them with
+//         a single call
+// @return: false if the buffer could not be written, nothing was drawn
+bool ParticleGenerator::drawStreamed(){
+  if(!vertexBuffer)
+    vertexBuffer = make_shared<StreamBuffer>();
+  size_t n = particles.size();
+  ParticleVertex* vertices =
+    (ParticleVertex*)vertexBuffer->map(n*sizeof(ParticleVertex));
+  if(vertices == nullptr)
+    return false;
+  const glm::vec3* positions = particles.getPositions();
+  for(size_t i = 0; i < n; i++){
+    glm::vec4 color = glm::clamp(particles.getColor(i), 0.f, 1.f)*255.f + 0.5f;
+    vertices[i].pos = positions[i];
+    vertices[i].color[0] = (GLubyte)color.x;
+    vertices[i].color[1] = (GLubyte)color.y;
+    vertices[i].color[2] = (GLubyte)color.z;
+    vertices[i].color[3] = (GLubyte)color.w;
+  }
+  if(!vertexBuffer->unmap())
+    return false;
+
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glEnableClientState(GL_COLOR_ARRAY);
+  glVertexPointer(3, GL_FLOAT, sizeof(ParticleVertex),
+    (const GLvoid*)offsetof(ParticleVertex, pos));
+  glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(ParticleVertex),
+    (const GLvoid*)offsetof(ParticleVertex, color));
+  glDrawArrays(GL_POINTS, 0, n);
+  glDisableClientState(GL_COLOR_ARRAY);
+  glDisableClientState(GL_VERTEX_ARRAY);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Draw the particles one vertex at a time, for contexts without
+//         buffer objects
+void ParticleGenerator::drawImmediate(){
+  glBegin(GL_POINTS);
+  for(size_t i = 0; i < particles.size(); i++){
+    glm::vec4 color = particles.getColor(i);
+    glm::vec3& pos = particles.getPosition(i);
+    glColor4f(color.x, color.y, color.z, color.w);
+    glVertex3f(pos.x, pos.y, pos.z);
+  }
+  glEnd();
+}
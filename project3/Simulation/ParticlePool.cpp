@@ -0,0 +1,250 @@
+#include "ParticlePool.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Reserve room for the given number of particles in every array, so
+//		   that spawning never reallocates during the simulation, and size
+//		   the timing wheel
+// @param capacity: maximum number of particles the pool will hold
+// @param maxLongevity: longest lifetime a particle can be given
+void
+ParticlePool::reserve(size_t capacity, int maxLongevity){
+	positions.reserve(capacity);
+	velocities.reserve(capacity);
+	accelerations.reserve(capacity);
+	deathFrames.reserve(capacity);
+	longevities.reserve(capacity);
+	flags.reserve(capacity);
+	ids.reserve(capacity);
+	slots.reserve(capacity);
+	freeIds.reserve(capacity);
+	resizeWheel(maxLongevity);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Add a new, moving particle to the pool
+// @param pos: starting position of particle
+// @param vel: starting velocity of particle
+// @param longevity: the longevity of particle
+// @return: index of the new particle
+size_t
+ParticlePool::add(glm::vec3 pos, glm::vec3 vel, int longevity){
+	positions.push_back(pos);
+	velocities.push_back(vel);
+	accelerations.push_back(glm::vec3(0,0,0));
+	deathFrames.push_back(frame + longevity);
+	longevities.push_back(longevity);
+	flags.push_back(0);
+	size_t i = positions.size() - 1;
+
+	int id;
+	if(freeIds.empty()){
+		id = slots.size();
+		slots.push_back(i);
+	} else {
+		id = freeIds.back();
+		freeIds.pop_back();
+		slots[id] = i;
+	}
+	ids.push_back(id);
+	if(longevity >= (int)wheel.size())
+		resizeWheel(longevity);
+	wheel[(frame + longevity) % wheel.size()].push_back(id);
+
+	// Keep the moving partition contiguous
+	if(i != numAwake)
+		swap(i, numAwake);
+	return numAwake++;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Remove the particle at the given index in constant time. The hole
+//		   is filled from the end of its partition, and a hole left in the
+//		   moving partition is filled from the end of the pool. The order of
+//		   particles is not kept.
+// @param i: index of the particle
+void
+ParticlePool::remove(size_t i){
+	freeIds.push_back(ids[i]);
+	size_t last = positions.size() - 1;
+	if(i < numAwake){
+		numAwake--;
+		move(numAwake, i);
+		move(last, numAwake);
+	} else {
+		move(last, i);
+	}
+	popBack();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Remove the particles whose longevity ends in the current frame
+// @return: number of particles removed
+int
+ParticlePool::retireExpired(){
+	if(wheel.empty())
+		return 0;
+	vector<int>& bucket = wheel[frame % wheel.size()];
+	int retired = bucket.size();
+	for(int id : bucket)
+		remove(slots[id]);
+	bucket.clear();
+	return retired;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Give the timing wheel one bucket per frame of the given lifetime,
+//		   refiling the particles already in it if it grows
+// @param maxLongevity: longest lifetime the wheel must cover
+void
+ParticlePool::resizeWheel(int maxLongevity){
+	size_t numBuckets = max(maxLongevity, 0) + 1;
+	if(numBuckets <= wheel.size())
+		return;
+	wheel.assign(numBuckets, vector<int>());
+	for(size_t i = 0; i < positions.size(); i++)
+		wheel[deathFrames[i] % numBuckets].push_back(ids[i]);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Move every moving particle that came to rest during the last
+//		   update into the resting partition
+void
+ParticlePool::settle(){
+	for(size_t i = 0; i < numAwake;){
+		if(flags[i] & RestFlag)
+			swap(i, --numAwake);
+		else
+			i++;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Set every resting particle moving again, as what they rest on may
+//		   have moved
+void
+ParticlePool::wakeAll(){
+	for(size_t i = numAwake; i < flags.size(); i++)
+		flags[i] &= ~RestFlag;
+	numAwake = size();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Copy a particle into another slot
+// @param from: index of the particle to copy
+// @param to: index of the slot to overwrite
+void
+ParticlePool::move(size_t from, size_t to){
+	if(from == to)
+		return;
+	positions[to] = positions[from];
+	velocities[to] = velocities[from];
+	accelerations[to] = accelerations[from];
+	deathFrames[to] = deathFrames[from];
+	longevities[to] = longevities[from];
+	flags[to] = flags[from];
+	ids[to] = ids[from];
+	slots[ids[to]] = to;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Exchange the slots of two particles
+// @param a: index of the first particle
+// @param b: index of the second particle
+void
+ParticlePool::swap(size_t a, size_t b){
+	std::swap(positions[a], positions[b]);
+	std::swap(velocities[a], velocities[b]);
+	std::swap(accelerations[a], accelerations[b]);
+	std::swap(deathFrames[a], deathFrames[b]);
+	std::swap(longevities[a], longevities[b]);
+	std::swap(flags[a], flags[b]);
+	std::swap(ids[a], ids[b]);
+	slots[ids[a]] = a;
+	slots[ids[b]] = b;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Drop the last slot of every array
+void
+ParticlePool::popBack(){
+	positions.pop_back();
+	velocities.pop_back();
+	accelerations.pop_back();
+	deathFrames.pop_back();
+	longevities.pop_back();
+	flags.pop_back();
+	ids.pop_back();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Gather the state of a particle
+// @param i: index of the particle
+State
+ParticlePool::getState(size_t i){
+	State s;
+	s.acc = accelerations[i];
+	s.pos = positions[i];
+	s.vel = velocities[i];
+	return s;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Scatter the given state back into the arrays
+// @param i: index of the particle
+// @param s: new state of the particle
+void
+ParticlePool::setState(size_t i, State s){
+	accelerations[i] = s.acc;
+	positions[i] = s.pos;
+	velocities[i] = s.vel;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Update particle's state with Euler's integration
+// @param i: index of the particle
+// @param force: the cumulative forces affecting the particle
+// @param s: the current state of particle
+// @param t: timestep value
+void
+ParticlePool::update(size_t i, glm::vec3 force, State s, float t){
+	// Movement of particle
+	s.acc = force*(1/particleClass->mass); //F = m*a meaning a = F/m
+	glm::vec3 velocity = s.vel + (s.acc*(t));
+	float maxVel = particleClass->maxVel;
+	if(glm::length(velocity) > maxVel) {
+		glm::vec3 normalizedVel = glm::normalize(velocity);
+		velocity = (normalizedVel*(maxVel));
+	}
+	s.vel = velocity;
+	s.pos += (s.vel*(t));
+	setState(i, s);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Resolve the given collision
+// @param i: index of the particle
+// @param c: given collision
+void
+ParticlePool::resolveCollision(size_t i, Collision c){
+	glm::vec3& vel = velocities[i];
+	const ParticleClass& pc = *particleClass;
+	// Dot equation a · b   =   a.x*b.x + a.y*b.y + a.z*b.z
+	// so for example, if c.n = (0,1,0), then c.n dot vel gives vel.z, and 
+	// vn = (0, vel.y, 0);
+	glm::vec3 vn = c.n*(glm::dot(c.n, vel));
+	// vt = (vel.x, 0, vel.z)
+	glm::vec3 vt = vel - vn;
+	// vn = (0, -vel.y * elasticity, 0)
+	// Negate y to simulate reflection off surface, with regard to the normal dir 
+	// of the surface (etc. bouncing back up for y). Elasticity is sth like 0.9, 
+	// to slow the particle down after each bouncing
+	vn *= (-pc.elasticity);
+	// vt = (1-f)*vt, friction is small, to also simulate friction for x,z
+	vt *= (1 - pc.friction);
+	// velNew = (velNew.x, 0, velNew.z) + (0, velNew.y, 0);
+	vel = vn + vt;
+
+	//TODO remove hard constant for resting distance
+	if(glm::length(vel) < 0.5)
+		setRested(i);
+}
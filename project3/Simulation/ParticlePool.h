@@ -0,0 +1,87 @@
+//////////////////////////////////////////////////////////////////////////////
+// @brief: This class stores the particles of one generator as a structure of
+//		   arrays. Every attribute lives in its own contiguous array, indexed
+//		   by particle, so the simulation and drawing loops stream linearly
+//		   through memory instead of chasing one heap object per particle.
+//
+//		   The pool is split in two partitions: moving particles occupy
+//		   [0, getNumAwake()) and particles that have come to rest occupy
+//		   the rest. The simulation only integrates the first partition;
+//		   resting particles are only looked at to expire and to be drawn.
+//		   Ages are counted in simulation frames from the frame a particle
+//		   was spawned in, so resting particles age without being touched.
+//
+//		   Expiry is tracked with a timing wheel: a ring with one bucket per
+//		   frame of the longest lifetime. A particle's id is filed under the
+//		   frame it dies in when it is spawned, so each frame retires exactly
+//		   the particles in the current bucket without scanning the pool.
+//		   Ids stay fixed while particles are moved between slots.
+#ifndef PARTICLEPOOL_H
+#define PARTICLEPOOL_H
+#include "Particle.h"
+
+// Bits stored in the per-particle flags array
+enum ParticleFlag : unsigned char {
+	RestFlag = 1			   ///< Particle has come to rest
+};
+
+class ParticlePool {
+public:
+	void setClass(shared_ptr<const ParticleClass> _particleClass) {
+		particleClass = _particleClass; }
+	const ParticleClass& getClass() { return *particleClass; }
+	void reserve(size_t capacity, int maxLongevity);
+	size_t add(glm::vec3 pos, glm::vec3 vel, int longevity);
+	void remove(size_t i);
+	int retireExpired();
+	void settle();
+	void wakeAll();
+	void advanceFrame() { frame++; }
+	int getFrame() { return frame; }
+	size_t size() { return positions.size(); }
+	size_t getNumAwake() { return numAwake; }
+
+	// Raw arrays, for kernels working on runs of particles
+	glm::vec3* getPositions() { return positions.data(); }
+	glm::vec3* getVelocities() { return velocities.data(); }
+	glm::vec3* getAccelerations() { return accelerations.data(); }
+
+	// Per-particle access
+	State getState(size_t i);
+	void setState(size_t i, State s);
+	glm::vec3& getPosition(size_t i) { return positions[i]; }
+	glm::vec3& getVelocity(size_t i) { return velocities[i]; }
+	int getTimeAlive(size_t i) { return frame - (deathFrames[i] - longevities[i]); }
+	int getLongevity(size_t i) { return longevities[i]; }
+	bool hasRested(size_t i) { return flags[i] & RestFlag; }
+	void setRested(size_t i) { flags[i] |= RestFlag; }
+	glm::vec4 getColor(size_t i) {
+		return particleClass->getColor(getTimeAlive(i), longevities[i]); }
+
+	// Per-particle simulation
+	void update(size_t i, glm::vec3 force, State s, float t);
+	void resolveCollision(size_t i, Collision c);
+
+private:
+	shared_ptr<const ParticleClass> particleClass;	//< Attributes shared by
+													//< every particle
+	vector<glm::vec3> positions;	   //< Position of each particle
+	vector<glm::vec3> velocities;	   //< Velocity of each particle
+	vector<glm::vec3> accelerations;   //< Acceleration of each particle
+	vector<int> deathFrames;		   //< Frame each particle expires at
+	vector<int> longevities;		   //< How long each particle "lives"
+	vector<unsigned char> flags;	   //< ParticleFlag bits of each particle
+	vector<int> ids;				   //< Fixed id of each particle
+	vector<size_t> slots;			   //< Index of the particle with each id
+	vector<int> freeIds;			   //< Ids not in use
+	vector<vector<int>> wheel;		   //< Ids of the particles dying in each
+									   //< frame, frame % wheel.size()
+	size_t numAwake{0};				   //< Number of particles still moving
+	int frame{0};					   //< Current simulation frame
+
+	void move(size_t from, size_t to);
+	void swap(size_t a, size_t b);
+	void popBack();
+	void resizeWheel(int maxLongevity);
+};
+#endif
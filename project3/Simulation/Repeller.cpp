@@ -3,24 +3,21 @@
 
 //////////////////////////////////////////////////////////////////////////////
 // @brief: Default constructor
-Repeller::Repeller(glm::vec3 pos, float range, float strength){
-	this->pos = pos;
-	this->range = range;
-	this->strength = strength;
+Repeller::Repeller(glm::vec3 pos, float range, float strength)
+	: ForceEmitter(pos, range, strength){
 }
 
 //////////////////////////////////////////////////////////////////////////////
-// @brief: retrieve force of repeller acting on particle
-// @param p: given particle
-glm::vec3 
-Repeller::getForce(shared_ptr<Particle> p){
-	glm::vec3 force = glm::vec3(0,0,0);
-	if(!activated)
-		return force;
-	glm::vec3 pPos = p->getCurrentState().pos;
-	glm::vec3 dir = pPos - pos;
-	if(glm::length(dir) < range){
-		force += (dir*(strength));
+// @brief: Add force of repeller acting on each particle of a batch
+// @param positions: positions of the n particles
+// @param n: number of particles
+// @param forces: forces of the n particles, accumulated into
+void
+Repeller::addForces(const glm::vec3* positions, size_t n, glm::vec3* forces){
+	for(size_t i = 0; i < n; i++){
+		glm::vec3 dir = positions[i] - pos;
+		if(glm::length(dir) < range){
+			forces[i] += (dir*(strength));
+		}
 	}
-	return force;
-}
\ No newline at end of file
+}
@@ -0,0 +1,411 @@
+#include "SceneBundle.h"
+#include "../Models/MeshCache.h"
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+#include <unistd.h>
+
+// Arrays stored in a bundle. The mesh images follow the header, then the
+// sections, each 16-byte aligned.
+enum BundleSection {OptionsSection, CameraSection, RepellerSection,
+  AttractorSection, GeneratorSection, ColorSection, ObstacleSection,
+  ModelSection, MeshSection, StringSection, NumBundleSections};
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: A string of the string section
+struct BundleString {
+  uint64_t offset;                //< Start in the string section
+  uint64_t length;                //< Length in bytes
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Scene parameters
+struct BundleOptions {
+  glm::vec3 sceneColor;
+  glm::vec3 planeColor;
+  int32_t planeSize;
+  float timeStep;
+  int32_t numThreads;
+  uint32_t unused;                //< Zero, padding made explicit so every
+                                  //< byte written is set
+  uint64_t seed;
+  BundleString profileFile;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: A particle generator
+struct BundleGenerator {
+  int32_t type;
+  int32_t maxParticles;
+  int32_t minimumLife;
+  int32_t maximumLife;
+  int32_t minNumGenerated;
+  int32_t maxNumGenerated;
+  int32_t timeIntervalGeneration;
+  float minVel;
+  float sd;
+  float forceStrength;
+  float mass;
+  float size;
+  float maxVel;
+  float elasticity;
+  float friction;
+  float alphaStart;
+  float alphaEnd;
+  glm::vec3 gravity;
+  Point point;
+  Line line;
+  Circle circle;
+  BundleString distribution;
+  uint64_t firstColor;            //< Index of the first color of the color
+                                  //< section
+  uint64_t numColors;             //< Number of colors
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: An obstacle
+struct BundleObstacle {
+  glm::vec3 point1;
+  glm::vec3 point2;
+  glm::vec3 point3;
+  glm::vec3 point4;
+  glm::vec3 normal;
+  uint32_t unused;                //< Zero, padding made explicit
+  BundleString style;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: A static model
+struct BundleModel {
+  BundleString file;              //< OBJ the model was placed from
+  BundleString name;
+  glm::vec3 pos;
+  glm::vec3 orientation;
+  glm::vec3 scale;
+  glm::vec3 color;
+  uint64_t mesh;                  //< Index of the mesh section
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: A mesh image, shared by the models of one OBJ
+struct BundleMesh {
+  BundleString file;              //< OBJ the mesh was loaded from
+  uint64_t offset;                //< Start of the image in the bundle
+  uint64_t size;                  //< Size of the image
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Start of a bundle
+struct SceneBundleHeader {
+  char magic[8];                  //< "SPDRSCNE"
+  uint32_t version;               //< SCENE_BUNDLE_VERSION
+  uint32_t byteOrder;             //< 0x01020304 in the writer's byte order
+  uint64_t offsets[NumBundleSections];  //< Start of each section
+  uint64_t counts[NumBundleSections];   //< Number of elements of each section
+  uint32_t elementSizes[NumBundleSections]; //< Size of an element of each
+                                            //< section for the writer
+};
+
+static const char bundleMagic[8] = {'S', 'P', 'D', 'R', 'S', 'C', 'N', 'E'};
+
+// Size of an element of each section
+static const size_t sectionSizes[NumBundleSections] = {sizeof(BundleOptions),
+  sizeof(CameraDescription), sizeof(EmitterDescription),
+  sizeof(EmitterDescription), sizeof(BundleGenerator), sizeof(glm::vec3),
+  sizeof(BundleObstacle), sizeof(BundleModel), sizeof(BundleMesh),
+  sizeof(char)};
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Report an unusable bundle and exit
+// @param file: the bundle
+// @param message: what is wrong
+[[noreturn]] static void
+invalid(const string& file, string message){
+  cerr << "Error: " << file << ": " << message << endl;
+  exit(1);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Whether a file is a scene bundle rather than a text input file
+// @param file: name of the file
+bool
+SceneBundle::isBundle(string file){
+  ifstream in(file, ios::binary);
+  char magic[sizeof(bundleMagic)];
+  return in.read(magic, sizeof(magic)) &&
+    memcmp(magic, bundleMagic, sizeof(magic)) == 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Write a scene to a bundle. The meshes of models that are not
+//         loaded yet are loaded first. Exits if the bundle can not be
+//         written.
+// @param file: name of the bundle
+// @param scene: the scene
+void
+SceneBundle::save(string file, const SceneDescription& scene){
+  string strings;
+  auto addString = [&strings](const string& s){
+    BundleString added = {strings.size(), s.size()};
+    strings += s;
+    return added;
+  };
+
+  BundleOptions options{};
+  options.sceneColor = scene.sceneColor;
+  options.planeColor = scene.planeColor;
+  options.planeSize = scene.planeSize;
+  options.timeStep = scene.timeStep;
+  options.numThreads = scene.numThreads;
+  options.seed = scene.seed;
+  options.profileFile = addString(scene.profileFile);
+
+  vector<BundleGenerator> generators(scene.generators.size(),
+    BundleGenerator{});
+  vector<glm::vec3> colors;
+  for(size_t i = 0; i < generators.size(); i++){
+    const GeneratorDescription& from = scene.generators[i];
+    BundleGenerator& to = generators[i];
+    to.type = from.type;
+    to.maxParticles = from.maxParticles;
+    to.minimumLife = from.minimumLife;
+    to.maximumLife = from.maximumLife;
+    to.minNumGenerated = from.minNumGenerated;
+    to.maxNumGenerated = from.maxNumGenerated;
+    to.timeIntervalGeneration = from.timeIntervalGeneration;
+    to.minVel = from.minVel;
+    to.sd = from.sd;
+    to.forceStrength = from.forceStrength;
+    to.mass = from.attributes.mass;
+    to.size = from.attributes.size;
+    to.maxVel = from.attributes.maxVel;
+    to.elasticity = from.attributes.elasticity;
+    to.friction = from.attributes.friction;
+    to.alphaStart = from.attributes.alphaStart;
+    to.alphaEnd = from.attributes.alphaEnd;
+    to.gravity = from.gravity;
+    to.point = from.point;
+    to.line = from.line;
+    to.circle = from.circle;
+    to.distribution = addString(from.distribution);
+    to.firstColor = colors.size();
+    to.numColors = from.attributes.colors.size();
+    colors.insert(colors.end(), from.attributes.colors.begin(),
+      from.attributes.colors.end());
+  }
+
+  vector<BundleObstacle> obstacles(scene.obstacles.size(), BundleObstacle{});
+  for(size_t i = 0; i < obstacles.size(); i++){
+    const ObstacleDescription& from = scene.obstacles[i];
+    obstacles[i].point1 = from.point1;
+    obstacles[i].point2 = from.point2;
+    obstacles[i].point3 = from.point3;
+    obstacles[i].point4 = from.point4;
+    obstacles[i].normal = from.normal;
+    obstacles[i].style = addString(from.style);
+  }
+
+  // One mesh per OBJ, in order of first use
+  vector<BundleModel> models(scene.models.size(), BundleModel{});
+  vector<BundleMesh> meshes;
+  vector<shared_ptr<const ModelAsset>> assets;
+  unordered_map<string, uint64_t> meshIndices;
+  for(size_t i = 0; i < models.size(); i++){
+    const ModelDescription& from = scene.models[i];
+    auto mesh = meshIndices.emplace(from.file, meshes.size());
+    if(mesh.second){
+      assets.push_back(from.asset ? from.asset : ModelAsset::load(from.file));
+      meshes.push_back({addString(from.file), 0, 0});
+    }
+    models[i].file = addString(from.file);
+    models[i].name = addString(from.name);
+    models[i].pos = from.pos;
+    models[i].orientation = from.orientation;
+    models[i].scale = from.scale;
+    models[i].color = from.color;
+    models[i].mesh = mesh.first->second;
+  }
+
+  SceneBundleHeader header{};
+  memcpy(header.magic, bundleMagic, sizeof(bundleMagic));
+  header.version = SCENE_BUNDLE_VERSION;
+  header.byteOrder = 0x01020304;
+  const void* data[NumBundleSections] = {&options, &scene.camera,
+    scene.repellers.data(), scene.attractors.data(), generators.data(),
+    colors.data(), obstacles.data(), models.data(), meshes.data(),
+    strings.data()};
+  size_t counts[NumBundleSections] = {1, 1, scene.repellers.size(),
+    scene.attractors.size(), generators.size(), colors.size(),
+    obstacles.size(), models.size(), meshes.size(), strings.size()};
+
+  // Write a temporary file and move it in place, so a reader never maps a
+  // half written bundle
+  string tempPath = file + "." + to_string(getpid()) + ".tmp";
+  ofstream out(tempPath, ios::binary);
+  out.write((const char*)&header, sizeof(header));
+  static const char padding[16] = {0};
+  for(size_t i = 0; i < meshes.size(); i++){
+    out.write(padding, (16 - out.tellp() % 16) % 16);
+    meshes[i].offset = out.tellp();
+    MeshCache::write(out, assets[i]->mesh, assets[i]->centerOfMass);
+    meshes[i].size = (uint64_t)out.tellp() - meshes[i].offset;
+  }
+  for(int i = 0; i < NumBundleSections; i++){
+    out.write(padding, (16 - out.tellp() % 16) % 16);
+    header.offsets[i] = out.tellp();
+    header.counts[i] = counts[i];
+    header.elementSizes[i] = sectionSizes[i];
+    out.write((const char*)data[i], counts[i]*sectionSizes[i]);
+  }
+  out.seekp(0);
+  out.write((const char*)&header, sizeof(header));
+  out.close();
+  if(!out || rename(tempPath.c_str(), file.c_str()) != 0){
+    unlink(tempPath.c_str());
+    cerr << "Error: Unable to write scene bundle " << file << endl;
+    exit(1);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Read a scene from a bundle. The meshes of the models stay in the
+//         mapped bundle. Exits if the bundle is unusable.
+// @param file: name of the bundle
+// @param scene: set to the scene of the bundle
+void
+SceneBundle::load(string file, SceneDescription& scene){
+  shared_ptr<MappedFile> input = make_shared<MappedFile>(file);
+  if(!input->isOpen()){
+    cerr << "Error: Unable to open file " << file << endl;
+    exit(1);
+  }
+
+  // Written by this version, on this kind of machine
+  if(input->size() < sizeof(SceneBundleHeader))
+    invalid(file, "not a scene bundle");
+  const SceneBundleHeader& header = *(const SceneBundleHeader*)input->begin();
+  if(memcmp(header.magic, bundleMagic, sizeof(bundleMagic)) != 0)
+    invalid(file, "not a scene bundle");
+  if(header.version != SCENE_BUNDLE_VERSION || header.byteOrder != 0x01020304)
+    invalid(file, "scene bundle of another version or machine, compile the "
+      "scene again");
+  for(int i = 0; i < NumBundleSections; i++){
+    uint64_t offset = header.offsets[i], count = header.counts[i];
+    if(header.elementSizes[i] != sectionSizes[i])
+      invalid(file, "scene bundle of another version or machine, compile the "
+        "scene again");
+    if(offset % 16 != 0 || offset > input->size() ||
+      count > (input->size() - offset)/sectionSizes[i])
+      invalid(file, "damaged scene bundle");
+  }
+  if(header.counts[OptionsSection] != 1 || header.counts[CameraSection] != 1)
+    invalid(file, "damaged scene bundle");
+
+  auto section = [&](BundleSection which){
+    return input->begin() + header.offsets[which];
+  };
+  const char* strings = section(StringSection);
+  auto getString = [&](BundleString s){
+    uint64_t size = header.counts[StringSection];
+    if(s.offset > size || s.length > size - s.offset)
+      invalid(file, "damaged scene bundle");
+    return string(strings + s.offset, s.length);
+  };
+
+  const BundleOptions& options = *(const BundleOptions*)section(OptionsSection);
+  scene.sceneColor = options.sceneColor;
+  scene.planeColor = options.planeColor;
+  scene.planeSize = options.planeSize;
+  scene.timeStep = options.timeStep;
+  scene.numThreads = options.numThreads;
+  scene.seed = options.seed;
+  scene.profileFile = getString(options.profileFile);
+  scene.camera = *(const CameraDescription*)section(CameraSection);
+  const EmitterDescription* repellers =
+    (const EmitterDescription*)section(RepellerSection);
+  scene.repellers.assign(repellers, repellers + header.counts[RepellerSection]);
+  const EmitterDescription* attractors =
+    (const EmitterDescription*)section(AttractorSection);
+  scene.attractors.assign(attractors,
+    attractors + header.counts[AttractorSection]);
+
+  const BundleGenerator* generators =
+    (const BundleGenerator*)section(GeneratorSection);
+  const glm::vec3* colors = (const glm::vec3*)section(ColorSection);
+  scene.generators.resize(header.counts[GeneratorSection]);
+  for(size_t i = 0; i < scene.generators.size(); i++){
+    const BundleGenerator& from = generators[i];
+    GeneratorDescription& to = scene.generators[i];
+    if(from.type < PointType || from.type > FireType ||
+      from.firstColor > header.counts[ColorSection] ||
+      from.numColors > header.counts[ColorSection] - from.firstColor)
+      invalid(file, "damaged scene bundle");
+    to.type = (GeneratorType)from.type;
+    to.point = from.point;
+    to.line = from.line;
+    to.circle = from.circle;
+    to.distribution = getString(from.distribution);
+    to.maxParticles = from.maxParticles;
+    to.minimumLife = from.minimumLife;
+    to.maximumLife = from.maximumLife;
+    to.minNumGenerated = from.minNumGenerated;
+    to.maxNumGenerated = from.maxNumGenerated;
+    to.timeIntervalGeneration = from.timeIntervalGeneration;
+    to.minVel = from.minVel;
+    to.gravity = from.gravity;
+    to.sd = from.sd;
+    to.forceStrength = from.forceStrength;
+    to.attributes.mass = from.mass;
+    to.attributes.size = from.size;
+    to.attributes.maxVel = from.maxVel;
+    to.attributes.elasticity = from.elasticity;
+    to.attributes.friction = from.friction;
+    to.attributes.alphaStart = from.alphaStart;
+    to.attributes.alphaEnd = from.alphaEnd;
+    to.attributes.colors.assign(colors + from.firstColor,
+      colors + from.firstColor + from.numColors);
+  }
+
+  const BundleObstacle* obstacles =
+    (const BundleObstacle*)section(ObstacleSection);
+  scene.obstacles.resize(header.counts[ObstacleSection]);
+  for(size_t i = 0; i < scene.obstacles.size(); i++){
+    scene.obstacles[i].point1 = obstacles[i].point1;
+    scene.obstacles[i].point2 = obstacles[i].point2;
+    scene.obstacles[i].point3 = obstacles[i].point3;
+    scene.obstacles[i].point4 = obstacles[i].point4;
+    scene.obstacles[i].normal = obstacles[i].normal;
+    scene.obstacles[i].style = getString(obstacles[i].style);
+  }
+
+  // The meshes are viewed in place; the mapping lives as long as they do
+  const BundleMesh* meshes = (const BundleMesh*)section(MeshSection);
+  vector<shared_ptr<const ModelAsset>> assets;
+  for(uint64_t i = 0; i < header.counts[MeshSection]; i++){
+    shared_ptr<ModelAsset> asset = make_shared<ModelAsset>();
+    asset->file = getString(meshes[i].file);
+    if(!MeshCache::view(input, meshes[i].offset, meshes[i].size, asset->mesh,
+      asset->centerOfMass))
+      invalid(file, "damaged mesh of " + asset->file);
+    assets.push_back(asset);
+  }
+
+  const BundleModel* models = (const BundleModel*)section(ModelSection);
+  scene.models.resize(header.counts[ModelSection]);
+  for(size_t i = 0; i < scene.models.size(); i++){
+    const BundleModel& from = models[i];
+    ModelDescription& to = scene.models[i];
+    if(from.mesh >= assets.size())
+      invalid(file, "damaged scene bundle");
+    to.file = getString(from.file);
+    to.name = getString(from.name);
+    to.pos = from.pos;
+    to.orientation = from.orientation;
+    to.scale = from.scale;
+    to.color = from.color;
+    to.asset = assets[from.mesh];
+  }
+}
@@ -0,0 +1,29 @@
+//////////////////////////////////////////////////////////////////////////////
+// @brief: This class represents a compiled scene bundle: one binary file
+//		   holding a whole resolved scene, its options, camera, emitters,
+//		   generators, obstacles and static models, along with the meshes
+//		   of the models. Loading a bundle maps it and reads fixed records,
+//		   with no text parsed; the meshes are used straight from the
+//		   mapping, as mesh cache images.
+//		   A bundle is compiled from a scene's input file with
+//		   spiderling-compile, and is then independent of the text files
+//		   and OBJs it was compiled from. A bundle written by another
+//		   version or on another kind of machine is refused; compile it
+//		   again.
+#ifndef SCENEBUNDLE_H
+#define SCENEBUNDLE_H
+#include <string>
+#include "SceneDescription.h"
+
+using namespace std;
+
+// Bump when the layout of the file or of the bundled structs changes
+#define SCENE_BUNDLE_VERSION 1
+
+class SceneBundle {
+public:
+	static bool isBundle(string file);
+	static void save(string file, const SceneDescription& scene);
+	static void load(string file, SceneDescription& scene);
+};
+#endif
@@ -0,0 +1,51 @@
+#include "SceneDescription.h"
+#include "../Utilities/ConfigSchema.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Read the scene's input file and the files it names. Errors are
+//         thrown as ConfigError.
+// @param inputFile: name of the given inputFile
+void SceneDescription::read(string inputFile){
+  ConfigReader reader(inputFile);
+  files.push_back(inputFile);
+  ConfigSchema schema;
+  schema.add("MeshCache", meshCache)
+    .add("StaticModels", [this](ConfigReader& line){
+      line.expectValues(1);
+      files.push_back(line.getString(0));
+      Model::parseInModels(files.back(), models);
+    })
+    .add("Camera", [this](ConfigReader& line){
+      line.expectValues(0);
+      camera.read(line);
+    })
+    .add("ParticleGenerators", [this](ConfigReader& line){
+      line.expectValues(1);
+      files.push_back(line.getString(0));
+      ParticleGenerator::parseInGenerators(files.back(), generators);
+    })
+    .add("SceneColor", sceneColor)
+    .add("PlaneColor", planeColor)
+    .add("PlaneDimension", planeSize)
+    .add("TimeStep", timeStep)
+    .add("Threads", numThreads)
+    .add("Seed", seed)
+    .add("Profile", profileFile)
+    .add("Obstacles", [this](ConfigReader& line){
+      line.expectValues(1);
+      files.push_back(line.getString(0));
+      Obstacle::parseInObstacles(files.back(), obstacles);
+    })
+    .add("Repeller", [this](ConfigReader& line){
+      line.expectValues(5);
+      repellers.push_back({line.getVec3(0), line.getFloat(3),
+        line.getFloat(4)});
+    })
+    .add("Attractor", [this](ConfigReader& line){
+      line.expectValues(5);
+      attractors.push_back({line.getVec3(0), line.getFloat(3),
+        line.getFloat(4)});
+    });
+  while(reader.nextLine())
+    schema.bind(reader);
+}
@@ -0,0 +1,43 @@
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Everything a scene is built from, resolved from its input file:
+//		   the options, the camera, the emitters, and the generators,
+//		   obstacles and static models listed by the files the input file
+//		   names. The whole scene is read into this before anything is
+//		   built, so options apply wherever they appear in the file. A scene
+//		   is either read from its text files or loaded from a scene bundle.
+#ifndef SCENEDESCRIPTION_H
+#define SCENEDESCRIPTION_H
+#include <string>
+#include <vector>
+
+#include "../Utilities/Camera.h"
+#include "ParticleGenerator.h"
+#include "Obstacle.h"
+#include "ForceEmitter.h"
+
+using namespace std;
+
+struct SceneDescription {
+	// Scene parameters
+	glm::vec3 sceneColor{1.f, 1.f, 1.f};	//< Background color
+	glm::vec3 planeColor{1.f, 1.f, 1.f};	//< Color of the ground plane
+	int planeSize{0};						//< Half width of the ground plane
+	float timeStep{0.f};					//< Time step of an update
+	int numThreads{1};			//< Threads updating particles, 0 for one per core
+	uint64_t seed{0};			//< Seed of the particle generators, 0 for a
+								//< seed taken from the clock
+	string profileFile;			//< Trace of the profiler, empty for none
+	string meshCache;			//< MeshCache option, empty if not given
+
+	CameraDescription camera;
+	vector<EmitterDescription> repellers;
+	vector<EmitterDescription> attractors;
+	vector<GeneratorDescription> generators;	//< In file order
+	vector<ObstacleDescription> obstacles;		//< In file order
+	vector<ModelDescription> models;			//< Static models, in file order
+	vector<string> files;		//< Text files read, the input file first; none
+								//< for a bundle
+
+	void read(string inputFile);
+};
+#endif
@@ -1,142 +1,265 @@
 #include "Simulator.h"
+#include "Integrator.h"
+#include "SceneBundle.h"
+#include "../Models/MeshCache.h"
 
 //////////////////////////////////////////////////////////////////////////////
 // @brief: Constructor
-//		   Read in paremeters for the simulation configurations
-//@ param inputFile: name of the given inputFile
+//		   Read in paremeters for the simulation configurations, then build
+//		   the scene. The static models may still be loading on return.
+//@ param inputFile: name of the given inputFile, or of a compiled scene
+//        bundle
 Simulator::Simulator(string inputFile){	
-	// Initialize variables
-	sceneColor = glm::vec3(1.0, 1.0, 1.0);
-
-	// declare an input-file stream variable for reading
-  ifstream inputFileStream;
-
-  // open file and check that it was successfully opened
-  inputFileStream.open(inputFile);
-  if (!inputFileStream.is_open()){
-   cout << "inputFile: " << inputFile << endl;
-   cerr << "Error: Unable to open file " << inputFile << endl;
-   exit(1);
+  if(SceneBundle::isBundle(inputFile))
+    SceneBundle::load(inputFile, description);
+  else{
+    try{
+      description.read(inputFile);
+    } catch(const ConfigError& e){
+      cerr << "Error: " << e.what() << endl;
+      exit(1);
+    }
+  }
+  buildScene(description);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Destructor, gives up loading the static models that have not
+//         started loading
+Simulator::~Simulator(){
+  stopLoading = true;
+  if(modelLoader.joinable())
+    modelLoader.join();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Build the objects of the scene. The static models load on a
+//         thread of their own while the generators and obstacles are built.
+// @param scene: objects to build
+void Simulator::buildScene(const SceneDescription& scene){
+  sceneColor = scene.sceneColor;
+  planeColor = scene.planeColor;
+  planeSize = scene.planeSize;
+  timeStep = scene.timeStep;
+  numThreads = scene.numThreads;
+  seed = scene.seed;
+  if(!scene.profileFile.empty())
+    Profiler::enable(scene.profileFile);
+  // Set before the loader starts, and never again while it runs
+  if(!scene.meshCache.empty())
+    MeshCache::setDirectory(scene.meshCache);
+  camera.configure(scene.camera);
+
+  if(!scene.models.empty()){
+    loadedModels.assign(scene.models.size(), nullptr);
+    modelLoader = thread(&Simulator::loadModels, this, scene.models);
   }
+  for(auto& description : scene.generators)
+    generators.push_back(make_shared<ParticleGenerator>(description, timeStep));
+  for(auto& description : scene.obstacles)
+    obstacles.push_back(make_shared<Obstacle>(description));
+  for(auto& description : scene.repellers)
+    repellers.push_back(make_shared<Repeller>(description.pos,
+      description.range, description.strength));
+  for(auto& description : scene.attractors)
+    attractors.push_back(make_shared<Attractor>(description.pos,
+      description.range, description.strength));
+
+  // Without a Seed option every run is different
+  if(seed == 0)
+    seed = chrono::system_clock::now().time_since_epoch().count();
+  for(auto& generator : generators)
+    generator->seedRandom(seed, nextGeneratorId++);
+  threadPool = make_shared<ThreadPool>(numThreads);
+}
 
-  while (inputFileStream.good()){
-        // Read each line
-    string input;
-    getline(inputFileStream, input);
-
-          // Skip to next line if line is empty or starts with pound sign
-    if(input == "")
-      continue;
-    else if (input[0] == '#')
-      continue;
-
-    vector<string> tokens;
-    Model::tokenize(input, " ", tokens);
-    if(tokens[0] == "StaticModels")
-     Model::parseInModels(tokens[1], staticModels);
-    if(tokens[0] == "Camera")
-       camera.configureParams(inputFileStream);
-    if(tokens[0] == "ParticleGenerators")
-      ParticleGenerator::parseInGenerators(tokens[1], generators, timeStep);
-    if(tokens[0] == "SceneColor")
-      sceneColor = glm::vec3(atof(tokens[1].c_str()), atof(tokens[2].c_str()), atof(tokens[3].c_str()));
-    if(tokens[0] == "PlaneColor")
-      planeColor = glm::vec3(atof(tokens[1].c_str()), atof(tokens[2].c_str()), atof(tokens[3].c_str()));
-    if(tokens[0] == "PlaneDimension")
-      planeSize = atof(tokens[1].c_str());
-    if(tokens[0] == "TimeStep")
-      timeStep = atof(tokens[1].c_str());
-    if(tokens[0] == "Obstacles")
-      Obstacle::parseInObstacles(tokens[1], obstacles);
-    if(tokens[0] == "Repeller"){
-      glm::vec3 pos = glm::vec3(atof(tokens[1].c_str()), atof(tokens[2].c_str()), atof(tokens[3].c_str()));
-      shared_ptr<Repeller> repeller = make_shared<Repeller>(pos, atof(tokens[4].c_str()), 
-        atof(tokens[5].c_str()));
-      repellers.push_back(repeller);
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Load the OBJs of the static models, several at a time, and place
+//         the models of each OBJ as soon as it is loaded. Models whose
+//         geometry came with the scene are placed without loading. Runs on
+//         modelLoader.
+// @param models: descriptions of the static models
+void Simulator::loadModels(vector<ModelDescription> models){
+  // Models placed from the same file wait for the same load
+  vector<string> files;
+  vector<vector<size_t>> placements;
+  unordered_map<string, size_t> fileIndices;
+  for(size_t i = 0; i < models.size(); i++){
+    auto file = fileIndices.emplace(models[i].file, files.size());
+    if(file.second){
+      files.push_back(models[i].file);
+      placements.emplace_back();
     }
-    if(tokens[0] == "Attractor"){
-      glm::vec3 pos = glm::vec3(atof(tokens[1].c_str()), atof(tokens[2].c_str()), atof(tokens[3].c_str()));
-      shared_ptr<Attractor> attractor = make_shared<Attractor>(pos, atof(tokens[4].c_str()), 
-        atof(tokens[5].c_str()));
-      attractors.push_back(attractor);
-    } 
-    if(inputFileStream.fail()){
-      if (inputFileStream.eof())
-        break;
-      else{
-                // failed for some other reason than reaching eof
-                // print a message and exit
-        cerr << "Error reading data. " << endl;
-        exit(1);
+    placements[file.first->second].push_back(i);
+  }
+
+  // Several files load side by side on one thread each, a lone file is
+  // parsed on all of them, so loading never starts more than numThreads
+  int parseThreads = files.size() > 1 ? 1 : numThreads;
+  ThreadPool pool(files.size() > 1 ? numThreads : 1);
+  pool.parallelFor(0, files.size(), 1, [&](size_t first, size_t last){
+    for(size_t f = first; f < last && !stopLoading; f++){
+      shared_ptr<const ModelAsset> asset = models[placements[f][0]].asset;
+      string error;
+      if(!asset)
+        asset = ModelAsset::load(files[f], error, parseThreads);
+      lock_guard<mutex> guard(modelLock);
+      // The error is reported on the main thread, which exits
+      if(!asset){
+        if(loadError.empty())
+          loadError = error;
+        stopLoading = true;
+        modelsChanged = true;
+        return;
       }
+      for(size_t i : placements[f])
+        loadedModels[i] = make_shared<Model>(asset, models[i]);
+      modelsChanged = true;
     }
-  }
+  });
 }
 
 //////////////////////////////////////////////////////////////////////////////
-// @brief: Draw every simulated objects
-void
-Simulator::draw(){
-	glClearColor(sceneColor.x, sceneColor.y, sceneColor.z, 0.f);
-	glm::vec3 eyePos = camera.getEyePos();
-  glm::vec3 lookAt = camera.getLookAt();
-  gluLookAt(eyePos.x, eyePos.y, eyePos.z,
-   lookAt.x, lookAt.y, lookAt.z,
-   0.f, 1.f, 0.f);
-
-  glEnable(GL_LIGHTING);
-  glColor3f(1.0,0.f,0.f);
-  glPointSize(10);
-  glBegin(GL_POINTS);
-  glVertex3f(lookAt.x, lookAt.y, lookAt.z);
-  glColor3f(1.0,1.f,0.f);
-  for(auto& attractor : attractors){
-    glVertex3f(attractor->getPos().x, attractor->getPos().y, attractor->getPos().z);
+// @brief: Add the static models loaded since the last call to the drawn
+//         ones, keeping the order of the input file. Exits if an OBJ
+//         failed to load.
+void Simulator::collectModels(){
+  if(!modelsChanged.exchange(false))
+    return;
+  string error;
+  {
+    lock_guard<mutex> guard(modelLock);
+    error = loadError;
+    staticModels.clear();
+    for(auto& model : loadedModels)
+      if(model)
+        staticModels.push_back(model);
   }
-  glColor3f(1.0,1.f,1.f);
-  for(auto& repeller : repellers){
-    glVertex3f(repeller->getPos().x, repeller->getPos().y, repeller->getPos().z);
+  // Exit without holding the lock, as exiting joins modelLoader
+  if(!error.empty()){
+    cerr << "Error: " << error << endl;
+    exit(1);
   }
-  glEnd();
+}
 
-  drawPlane();
-  for(auto& model : staticModels)
-    model->draw();
-  glDisable(GL_LIGHTING);
-  for(auto& generator : generators)
-    generator->draw();
-  for(auto& obstacle : obstacles)
-    obstacle->draw();
- 
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Block until every static model is loaded. Exits if an OBJ failed
+//         to load.
+void Simulator::waitForModels(){
+  if(modelLoader.joinable())
+    modelLoader.join();
+  collectModels();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Watch the text files of the scene, so reloadChangedFiles picks up
+//         their edits. A scene loaded from a bundle has no files to watch.
+void Simulator::watchSceneFiles(){
+  if(description.files.empty())
+    return;
+  watcher = make_shared<FileWatcher>();
+  for(auto& file : description.files)
+    watcher->watch(file);
 }
 
 //////////////////////////////////////////////////////////////////////////////
-// @brief: Draw plane and axies
-void
-Simulator::drawPlane(){
-  glBegin(GL_LINES);
-  glLineWidth(5.0);
-  // Plane
-  glColor3f(planeColor.x, planeColor.y, planeColor.z);
-  for(int i = (-1)*planeSize; i < planeSize + 1; i+=5){
-    glVertex3f(i,0.0,planeSize);
-    glVertex3f(i,0.0,-planeSize);
+// @brief: Rebuild the objects whose description changed and keep the others.
+//         A description read again is matched with an equal one the objects
+//         were built from, wherever it is in the files, so adding or
+//         removing an object leaves the others alone.
+// @param built: descriptions the objects were built from
+// @param changed: descriptions read again
+// @param objects: the objects, one per description; set to one per
+//        description read again, in file order
+// @param build: makes the object of a description
+// @return: number of objects built
+template <class Description, class Object, class Build>
+static int
+rebuildChanged(const vector<Description>& built,
+  const vector<Description>& changed, vector<shared_ptr<Object>>& objects,
+  Build build){
+  vector<shared_ptr<Object>> rebuilt(changed.size());
+  vector<bool> matched(built.size(), false);
+  int numBuilt = 0;
+  for(size_t i = 0; i < changed.size(); i++){
+    size_t j = 0;
+    while(j < built.size() && (matched[j] || !(built[j] == changed[i])))
+      j++;
+    if(j < built.size()){
+      matched[j] = true;
+      rebuilt[i] = objects[j];
+    } else {
+      rebuilt[i] = build(changed[i]);
+      numBuilt++;
+    }
   }
-  for(int i = (-1)*planeSize; i < planeSize + 1; i+=5){
-    glVertex3f(planeSize, 0.0,i);
-    glVertex3f(-planeSize,0.0,i);
+  objects.swap(rebuilt);
+  return numBuilt;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: If a scene file was saved, read the scene again and rebuild the
+//         generators, repellers, attractors and obstacles whose description
+//         changed. Unchanged generators keep their live particles. The
+//         static models are not reloaded, nor the camera and the options
+//         objects are built with; the scene and plane colors are. A file
+//         with an error leaves the scene as it was.
+void Simulator::reloadChangedFiles(){
+  if(!watcher || !watcher->changed())
+    return;
+  SceneDescription changed;
+  try{
+    changed.read(description.files[0]);
+  } catch(const ConfigError& e){
+    cerr << "Warning: " << e.what() << ", scene not reloaded" << endl;
+    return;
   }
-  // Axies
-  glColor3f(1.0, 0.0, 0.0);
-  glVertex3f(0.0, 0.0, 0.0);
-  glVertex3f(20.0, 0.0, 0.0);
-  glColor3f(0.0, 1.0, 0.0);
-  glVertex3f(0.0, 0.0, 0.0);
-  glVertex3f(0.0, 20.0, 0.0);
-  glColor3f(0.0, 0.0, 1.0);
-  glVertex3f(0.0, 0.0, 0.0);
-  glVertex3f(0.0, 0.0, 20.0);
-  glEnd();
+  // Files the scene names now are watched too
+  for(auto& file : changed.files)
+    watcher->watch(file);
+
+  sceneColor = changed.sceneColor;
+  planeColor = changed.planeColor;
+  planeSize = changed.planeSize;
+  int numGenerators = rebuildChanged(description.generators,
+    changed.generators, generators,
+    [this](const GeneratorDescription& generator){
+      auto rebuilt = make_shared<ParticleGenerator>(generator, timeStep);
+      rebuilt->seedRandom(seed, nextGeneratorId++);
+      return rebuilt;
+    });
+  int numRepellers = rebuildChanged(description.repellers, changed.repellers,
+    repellers, [](const EmitterDescription& repeller){
+      return make_shared<Repeller>(repeller.pos, repeller.range,
+        repeller.strength);
+    });
+  int numAttractors = rebuildChanged(description.attractors,
+    changed.attractors, attractors,
+    [](const EmitterDescription& attractor){
+      return make_shared<Attractor>(attractor.pos, attractor.range,
+        attractor.strength);
+    });
+  int numObstacles = rebuildChanged(description.obstacles, changed.obstacles,
+    obstacles, [](const ObstacleDescription& obstacle){
+      return make_shared<Obstacle>(obstacle);
+    });
+  // Particles resting on a moved or removed obstacle would stay in the air
+  if(numObstacles > 0 || obstacles.size() != description.obstacles.size())
+    for(auto& generator : generators)
+      generator->getParticles().wakeAll();
+  description.sceneColor = changed.sceneColor;
+  description.planeColor = changed.planeColor;
+  description.planeSize = changed.planeSize;
+  description.generators = changed.generators;
+  description.repellers = changed.repellers;
+  description.attractors = changed.attractors;
+  description.obstacles = changed.obstacles;
+  description.files = changed.files;
+  cout << "Reloaded " << description.files[0] << ", rebuilt " << numGenerators
+    << " of " << generators.size() << " generators, " << numRepellers << " of "
+    << repellers.size() << " repellers, " << numAttractors << " of "
+    << attractors.size() << " attractors, " << numObstacles << " of "
+    << obstacles.size() << " obstacles" << endl;
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -144,56 +267,159 @@ Simulator::drawPlane(){
 //         delete any particle that has reached their longevities, generate 
 //         forces and apply those forces to particles to update 
 //         particles' movement, and check for collision.
+//         Particles are updated independently of each other, so the live
+//         particles of every generator are cut into chunks that the thread
+//         pool runs in parallel. The result does not depend on the number
+//         of threads.
+void Simulator::update(){
+  // Number of particles per parallel chunk
+  const size_t grainSize = 2048;
+  ProfileScope scope("update");
+
+  // Emission and retirement change the pools, so they stay serial
+  retiredCount = 0;
+  for(auto& generator : generators){
+    ParticlePool& particles = generator->getParticles();
+    particles.advanceFrame();
+    generator->generateParticles();
+    // Delete particles that reach the end of their longevity
+    ProfileScope retireScope("retire", generator->getId());
+    retiredCount += particles.retireExpired();
+  }
+
+  // Cut every generator's moving particles into chunks and run them all in
+  // one loop. Resting particles are not visited.
+  struct Chunk {
+    ParticleGenerator* generator;
+    size_t begin;
+    size_t end;
+  };
+  vector<Chunk> chunks;
+  for(auto& generator : generators){
+    size_t numAwake = generator->getParticles().getNumAwake();
+    for(size_t begin = 0; begin < numAwake; begin += grainSize)
+      chunks.push_back({generator.get(), begin,
+        min(numAwake, begin + grainSize)});
+  }
+  threadPool->parallelFor(0, chunks.size(), 1, [&](size_t first, size_t last){
+    for(size_t c = first; c < last; c++)
+      updateParticles(*chunks[c].generator, chunks[c].begin, chunks[c].end);
+  });
+
+  // Move particles that came to rest into the resting partition
+  for(auto& generator : generators){
+    ProfileScope settleScope("settle", generator->getId());
+    generator->getParticles().settle();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Update a range of a generator's moving particles by one time
+//         step. Forces are gathered for the whole range, the vector kernel
+//         takes the full step, then particles that crossed an obstacle are
+//         corrected.
+// @param generator: generator owning the particles
+// @param begin: index of the first particle to update
+// @param end: one past the index of the last particle to update
+void Simulator::updateParticles(ParticleGenerator& generator, size_t begin,
+  size_t end){
+  // Scratch space of this thread, reused between chunks
+  thread_local vector<State> oldStates;
+  thread_local vector<glm::vec3> forces;
+  ParticlePool& particles = generator.getParticles();
+  const ParticleClass& particleClass = particles.getClass();
+  size_t n = end - begin;
+  int id = generator.getId();
+  oldStates.resize(n);
+  forces.resize(n);
+  {
+    ProfileScope scope("forces", id);
+    for(size_t k = 0; k < n; k++)
+      oldStates[k] = particles.getState(begin + k);
+    computeForces(generator, begin, n, forces.data());
+  }
+  {
+    ProfileScope scope("integrate", id);
+    integrateParticles(particles.getPositions() + begin,
+      particles.getVelocities() + begin, particles.getAccelerations() + begin,
+      forces.data(), n, particleClass.mass, particleClass.maxVel, timeStep);
+  }
+  ProfileScope scope("collide", id);
+  for(size_t k = 0; k < n; k++)
+    resolveCollisions(generator, begin + k, oldStates[k], forces[k]);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Check a particle that has just taken a full time step against the
+//         obstacles. If it crossed one, move it only up to the obstacle,
+//         bounce it, and spend the rest of the time step the same way.
 /// @ ASSUMPTION: that because timeStep is small, the change in position
 /// is small enough that a particle can collide with only 1 obstacle in 
 /// the list of obstacles in one simulation step. Not robust, @TODO
 /// think of a way to address this (sorting will be too expensive?)
-void Simulator::update(){
-  for(auto& generator : generators){
-    generator->generateParticles();
-    vector<shared_ptr<Particle>>& particles = generator->getParticles();
-    for (auto p = particles.begin(); p != particles.end();) {
-      // Delete particle if it reaches the end of its longevity
-      if ((*p)->getTimeAlive() >= (*p)->getLongevity()) {
-        p = particles.erase(p);
-      } else {
-        if((*p)->hasRested()){
-          ++p;
-          continue;
-        }
-        // Otherwise update the particle's state
-        // Set timeRemaining (tr) equal to timeStep
-        float tr = timeStep;
-        while(tr > 0) {
-          State oldState = (*p)->getCurrentState();
-          // Resolve inner force from the generator
-          glm::vec3 force = generator->generateForces((*p));
-          // Resolve forces from repellers and attractors
-          for(auto& repeller : repellers)
-            force += repeller->getForce((*p));
-          for(auto& attractor : attractors)
-            force += attractor->getForce((*p));
-
-          // Update state of particle
-          (*p)->update(force, oldState, tr);
-
-          // Resolve collision (if there is)
-          Collision c;
-          for(auto& obstacle : obstacles){
-            c = obstacle->checkCollision(oldState, (*p)->getCurrentState());
-            if(!c.none){
-              (*p)->update(force, oldState, tr*c.f);
-              (*p)->resolveCollision(c);
-              tr -= tr*c.f;
-              break;
-            }
-          }
-          if(c.none){
-            tr = 0;
-          }
-        }
-        ++p;
-      }
-    }
+// @param generator: generator owning the particle
+// @param i: index of the particle
+// @param oldState: state of the particle before the step
+// @param force: force the step was taken with
+void Simulator::resolveCollisions(ParticleGenerator& generator, size_t i,
+  State oldState, glm::vec3 force){
+  ParticlePool& particles = generator.getParticles();
+  // Set timeRemaining (tr) equal to timeStep
+  float tr = timeStep;
+  Collision c = checkCollision(oldState, particles.getState(i));
+  while(!c.none){
+    particles.update(i, force, oldState, tr*c.f);
+    particles.resolveCollision(i, c);
+    tr -= tr*c.f;
+    if(tr <= 0)
+      break;
+    // Continue the step from the point of collision
+    oldState = particles.getState(i);
+    computeForces(generator, i, 1, &force);
+    particles.update(i, force, oldState, tr);
+    c = checkCollision(oldState, particles.getState(i));
   }
-}
\ No newline at end of file
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Sum the forces acting on a batch of particles
+// @param generator: generator owning the particles
+// @param begin: index of the first particle
+// @param n: number of particles
+// @param forces: set to the cumulative force acting on each particle
+void Simulator::computeForces(ParticleGenerator& generator, size_t begin,
+  size_t n, glm::vec3* forces){
+  // Resolve inner force from the generator
+  generator.generateForces(begin, n, forces);
+  if(repellers.empty() && attractors.empty())
+    return;
+
+  // Resolve forces from repellers and attractors. Emitters out of reach of
+  // the batch's bounding box are culled.
+  const glm::vec3* positions = generator.getParticles().getPositions() + begin;
+  glm::vec3 boundsMin = positions[0];
+  glm::vec3 boundsMax = positions[0];
+  for(size_t k = 1; k < n; k++){
+    boundsMin = glm::min(boundsMin, positions[k]);
+    boundsMax = glm::max(boundsMax, positions[k]);
+  }
+  for(auto& repeller : repellers)
+    repeller->accumulateForces(positions, n, boundsMin, boundsMax, forces);
+  for(auto& attractor : attractors)
+    attractor->accumulateForces(positions, n, boundsMin, boundsMax, forces);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Find the first obstacle crossed by a particle's move
+// @param oldState: state of the particle before the move
+// @param newState: state of the particle after the move
+// @return: the collision, with none set if no obstacle was crossed
+Collision Simulator::checkCollision(State oldState, State newState){
+  Collision c;
+  for(auto& obstacle : obstacles){
+    c = obstacle->checkCollision(oldState, newState);
+    if(!c.none)
+      break;
+  }
+  return c;
+}
@@ -7,6 +7,9 @@
 #include <stdlib.h>
 #include <string>
 #include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
 
 // #include "../Models/Model.h" Camera already includes Model.h
 #include "Attractor.h"
@@ -14,10 +17,18 @@
 #include "ParticleGenerator.h"
 #include "Repeller.h"
 #include "Obstacle.h"
+#include "../Utilities/ThreadPool.h"
+#include "../Utilities/Profiler.h"
+#include "../Utilities/FileWatcher.h"
+#include "SceneDescription.h"
 class Simulator {
 
 public:
 	Simulator(string inputFile);
+	~Simulator();
+	void waitForModels();
+	void watchSceneFiles();
+	void reloadChangedFiles();
 	void draw();
 	void generateScene();
 	void update();
@@ -25,6 +36,8 @@ public:
 	vector<shared_ptr<Attractor>>& getAttractors(){ return attractors; }
 	vector<shared_ptr<ParticleGenerator>>& getGenerators() { return generators; }
 	Camera& getCamera() {return camera;}
+	int getRetiredCount() { return retiredCount; }
+	uint64_t getSeed() { return seed; }
 
 private:
 	vector<shared_ptr<Model>> staticModels;
@@ -34,6 +47,22 @@ private:
 	vector<shared_ptr<Attractor>> attractors;
 
 	Camera camera;
+	SceneDescription description;		//< What the scene was built from, to
+										//< tell what a reload changes
+	shared_ptr<FileWatcher> watcher;	//< Watch on the scene's text files,
+										//< null if not watching
+	shared_ptr<ThreadPool> threadPool;	//< Workers sharing the particle updates
+
+	// Static models are loaded in the background and drawn once loaded
+	thread modelLoader;					//< Thread loading the static models
+	mutex modelLock;					//< Guards loadedModels
+	vector<shared_ptr<Model>> loadedModels;	//< Static models in file order,
+											//< null until loaded
+	atomic<bool> modelsChanged{false};	//< loadedModels changed since copied
+										//< to staticModels
+	atomic<bool> stopLoading{false};	//< Set to give up loading
+	string loadError;					//< First OBJ that failed to load,
+										//< guarded by modelLock
 
 	// Scene parameters
 	glm::vec3 sceneColor;
@@ -43,7 +72,22 @@ private:
 	string staticModelFile;
 	glm::vec3 cameraPos;
 	glm::vec3 cameraDir;
+	int retiredCount{0};		//< Number of particles retired by the last update
+	int numThreads{1};			//< Threads updating particles, 0 for one per core
+	uint64_t seed{0};			//< Seed of the particle generators, 0 for a
+								//< seed taken from the clock
+	uint32_t nextGeneratorId{0};	//< Id of the next generator built, so
+									//< every generator draws its own streams
+	void buildScene(const SceneDescription& scene);
+	void loadModels(vector<ModelDescription> models);
+	void collectModels();
 	void drawPlane();
+	void updateParticles(ParticleGenerator& generator, size_t begin, size_t end);
+	void resolveCollisions(ParticleGenerator& generator, size_t i,
+		State oldState, glm::vec3 force);
+	void computeForces(ParticleGenerator& generator, size_t begin, size_t n,
+		glm::vec3* forces);
+	Collision checkCollision(State oldState, State newState);
 
 };
 #endif
\ No newline at end of file
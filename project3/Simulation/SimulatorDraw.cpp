@@ -0,0 +1,75 @@
+#include "Simulator.h"
+#include "../Utilities/GL.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Draw every simulated objects. The profiled phases measure the
+//         time spent issuing GL calls, not the GPU time.
+void
+Simulator::draw(){
+  ProfileScope scope("draw");
+	glClearColor(sceneColor.x, sceneColor.y, sceneColor.z, 0.f);
+	glm::vec3 eyePos = camera.getEyePos();
+  glm::vec3 lookAt = camera.getLookAt();
+  gluLookAt(eyePos.x, eyePos.y, eyePos.z,
+   lookAt.x, lookAt.y, lookAt.z,
+   0.f, 1.f, 0.f);
+
+  glEnable(GL_LIGHTING);
+  glColor3f(1.0,0.f,0.f);
+  glPointSize(10);
+  glBegin(GL_POINTS);
+  glVertex3f(lookAt.x, lookAt.y, lookAt.z);
+  glColor3f(1.0,1.f,0.f);
+  for(auto& attractor : attractors){
+    glVertex3f(attractor->getPos().x, attractor->getPos().y, attractor->getPos().z);
+  }
+  glColor3f(1.0,1.f,1.f);
+  for(auto& repeller : repellers){
+    glVertex3f(repeller->getPos().x, repeller->getPos().y, repeller->getPos().z);
+  }
+  glEnd();
+
+  drawPlane();
+  {
+    ProfileScope modelScope("draw.models");
+    collectModels();
+    Model::drawAll(staticModels);
+  }
+  glDisable(GL_LIGHTING);
+  for(auto& generator : generators){
+    ProfileScope particleScope("draw.particles", generator->getId());
+    generator->draw();
+  }
+  ProfileScope obstacleScope("draw.obstacles");
+  for(auto& obstacle : obstacles)
+    obstacle->draw();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Draw plane and axies
+void
+Simulator::drawPlane(){
+  glBegin(GL_LINES);
+  glLineWidth(5.0);
+  // Plane
+  glColor3f(planeColor.x, planeColor.y, planeColor.z);
+  for(int i = (-1)*planeSize; i < planeSize + 1; i+=5){
+    glVertex3f(i,0.0,planeSize);
+    glVertex3f(i,0.0,-planeSize);
+  }
+  for(int i = (-1)*planeSize; i < planeSize + 1; i+=5){
+    glVertex3f(planeSize, 0.0,i);
+    glVertex3f(-planeSize,0.0,i);
+  }
+  // Axies
+  glColor3f(1.0, 0.0, 0.0);
+  glVertex3f(0.0, 0.0, 0.0);
+  glVertex3f(20.0, 0.0, 0.0);
+  glColor3f(0.0, 1.0, 0.0);
+  glVertex3f(0.0, 0.0, 0.0);
+  glVertex3f(0.0, 20.0, 0.0);
+  glColor3f(0.0, 0.0, 1.0);
+  glVertex3f(0.0, 0.0, 0.0);
+  glVertex3f(0.0, 0.0, 20.0);
+  glEnd();
+}
@@ -1,45 +1,31 @@
 #include "Camera.h"
+#include "ConfigSchema.h"
 
 //////////////////////////////////////////////////////////////////////////////
-// @brief: Rotate camera to the left on the xz plane, with reference to y axis
+// @brief: Read the camera's parameters, up to the line "end"
+// @param reader: reader on the line opening the camera's block
 void
-Camera::configureParams(ifstream& inputFileStream){
-	while (inputFileStream.good()){
-        // Read each line
-		string input;
-		getline(inputFileStream, input);
-
-		if(input == "end")
-			break;
-		
-		if(input == "")
-            continue;
-        else if (input[0] == '#')
-            continue;
-
-        // Skip to next line if line is empty or starts with pound sign
-		if(input == "")
-			continue;
-		else if (input[0] == '#')
-			continue;
+CameraDescription::read(ConfigReader& reader){
+	ConfigSchema schema;
+	schema.add("position", position)
+		.add("lookingDirection", lookingDirection)
+		.add("viewDist", viewDist)
+		.add("panDist", panDist)
+		.add("moveSpeed", moveSpeed);
+	schema.readBlock(reader);
+}
 
-		// Read in parameters for camera
-		vector<string> tokens;
-		Model::tokenize(input, " ", tokens);
-		if(tokens[0] == "position")
-			eyePos = glm::vec3(atof(tokens[1].c_str()), atof(tokens[2].c_str()), atof(tokens[3].c_str()));
-		if(tokens[0] ==  "lookingDirection")
-			dir = glm::vec3(atof(tokens[1].c_str()), atof(tokens[2].c_str()), atof(tokens[3].c_str()));
-		if(tokens[0] == "viewDist")
-			viewDist = atof(tokens[1].c_str());
-		if(tokens[0] == "panDist")
-			panDist = atof(tokens[1].c_str());
-		if(tokens[0] == "moveSpeed")
-			moveSpeed = atof(tokens[1].c_str());
-		
-		lookAt = eyePos + dir*viewDist;
-	}
-	return;
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Place the camera
+// @param description: parameters of the camera
+void
+Camera::configure(const CameraDescription& description){
+	eyePos = description.position;
+	dir = description.lookingDirection;
+	viewDist = description.viewDist;
+	panDist = description.panDist;
+	moveSpeed = description.moveSpeed;
+	lookAt = eyePos + dir*viewDist;
 }
 
 //////////////////////////////////////////////////////////////////////////////
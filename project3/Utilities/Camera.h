@@ -1,3 +1,5 @@
+#ifndef CAMERA_H
+#define CAMERA_H
 #include <fstream>
 #include <cstdlib>
 
@@ -11,9 +13,22 @@
 #include <iostream>
 
 #include "../Models/Model.h"
+#include "ConfigReader.h"
 
 using namespace std;
 
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Parameters of the camera, as listed in the scene's input file
+struct CameraDescription {
+	glm::vec3 position{0.f, 0.f, 0.f};			//< Eye position
+	glm::vec3 lookingDirection{0.f, 0.f, -1.f};	//< Direction looked at
+	float viewDist{1.f};		//< Length of view distance
+	float panDist{1.f};			//< Distance panned around
+	float moveSpeed{1.f};		//< Speed of moving
+
+	void read(ConfigReader& reader);
+};
+
 class Camera {
 private:
 	float rotateAngle{0.02f};
@@ -39,7 +54,7 @@ public:
 	void setRotateAngle(float angle){ rotateAngle = angle; }
 	void setMoveSpeed(float speed){ moveSpeed = speed; }
 	void setPosition(glm::vec3 eyepos, glm::vec3 lookat);
-	void configureParams(ifstream& inputFileStream);
+	void configure(const CameraDescription& description);
 
 	void rotateLeft();			//< Camera rotates left 
 	void rotateRight();			//< Camera rotates right
@@ -54,4 +69,5 @@ public:
 	void panLeft();				//< Eye point moves left
 	void panRight();			//< Eye point moves right
 
-};
\ No newline at end of file
+};
+#endif
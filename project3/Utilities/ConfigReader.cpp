@@ -0,0 +1,174 @@
+#include "ConfigReader.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <cstdlib>
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Whether a character separates tokens
+static inline bool
+isSeparator(char c){
+	return c == ' ' || c == '\t' || c == ',' || c == '\r';
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Constructor, opens the file
+// @param _file: name of the file
+ConfigReader::ConfigReader(string _file) : file(_file), input(_file){
+	if(!input.isOpen())
+		throw ConfigError("Unable to open file " + file);
+	p = input.begin();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Move to the next line holding a key, skipping blank lines and
+//		   comments
+// @return: false at the end of the file
+bool
+ConfigReader::nextLine(){
+	const char* end = input.end();
+	while(p < end){
+		const char* lineEnd = (const char*)memchr(p, '\n', end - p);
+		if(lineEnd == nullptr)
+			lineEnd = end;
+		lineNumber++;
+
+		numTokens = 0;
+		const char* c = p;
+		while(c < lineEnd){
+			while(c < lineEnd && isSeparator(*c))
+				c++;
+			if(c == lineEnd || (numTokens == 0 && *c == '#'))
+				break;
+			const char* first = c;
+			while(c < lineEnd && !isSeparator(*c))
+				c++;
+			if(numTokens == CONFIG_MAX_TOKENS)
+				error("more than " + to_string(CONFIG_MAX_TOKENS) + " tokens");
+			tokens[numTokens++] = string_view(first, c - first);
+		}
+		p = lineEnd < end ? lineEnd + 1 : end;
+		if(numTokens > 0)
+			return true;
+	}
+	numTokens = 0;
+	return false;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Move to the line opening the next block
+// @return: false at the end of the file
+bool
+ConfigReader::nextBlock(){
+	if(!nextLine())
+		return false;
+	if(getKey() != "start")
+		error("expected start, not '" + string(getKey()) + "'");
+	expectValues(0);
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Value of the current line
+// @param i: index of the value, the key not counted
+string_view
+ConfigReader::getValue(size_t i){
+	if(i + 1 >= numTokens)
+		error("missing value " + to_string(i + 1) + " of " +
+			string(getKey()));
+	return tokens[i + 1];
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Value of the current line, as a float
+// @param i: index of the value
+float
+ConfigReader::getFloat(size_t i){
+	string_view value = getValue(i);
+	const char* first = value.data();
+	const char* last = first + value.size();
+	if(first < last && *first == '+')
+		first++;
+	double number;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+	from_chars_result result = from_chars(first, last, number);
+	bool valid = result.ec == errc() && result.ptr == last;
+#else
+	// Standard libraries without floating point from_chars: strtod on a
+	// terminated copy, as the mapped file need not end in a terminator
+	char digits[64];
+	size_t n = min((size_t)(last - first), sizeof(digits) - 1);
+	memcpy(digits, first, n);
+	digits[n] = '\0';
+	char* end;
+	number = strtod(digits, &end);
+	bool valid = n > 0 && end == digits + (last - first);
+#endif
+	if(!valid)
+		error("invalid number '" + string(value) + "'");
+	return (float)number;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Value of the current line, as an int
+// @param i: index of the value
+int
+ConfigReader::getInt(size_t i){
+	string_view value = getValue(i);
+	const char* first = value.data();
+	const char* last = first + value.size();
+	if(first < last && *first == '+')
+		first++;
+	int number;
+	from_chars_result result = from_chars(first, last, number);
+	if(result.ec != errc() || result.ptr != last)
+		error("invalid integer '" + string(value) + "'");
+	return number;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Value of the current line, as an unsigned 64-bit integer
+// @param i: index of the value
+uint64_t
+ConfigReader::getUInt64(size_t i){
+	string_view value = getValue(i);
+	uint64_t number;
+	from_chars_result result = from_chars(value.data(),
+		value.data() + value.size(), number);
+	if(result.ec != errc() || result.ptr != value.data() + value.size())
+		error("invalid integer '" + string(value) + "'");
+	return number;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Three values of the current line, as a vector
+// @param i: index of the first value
+glm::vec3
+ConfigReader::getVec3(size_t i){
+	return glm::vec3(getFloat(i), getFloat(i + 1), getFloat(i + 2));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Value of the current line, copied into a string
+// @param i: index of the value
+string
+ConfigReader::getString(size_t i){
+	return string(getValue(i));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Check the current line has the given number of values
+void
+ConfigReader::expectValues(size_t n){
+	if(getNumValues() != n)
+		error(string(getKey()) + " takes " + to_string(n) + " values, not " +
+			to_string(getNumValues()));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Report an error at the current line
+// @param message: what is wrong
+void
+ConfigReader::error(string message){
+	throw ConfigError(file + ", line " + to_string(lineNumber) + ": " + message);
+}
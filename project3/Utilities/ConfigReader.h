@@ -0,0 +1,62 @@
+//////////////////////////////////////////////////////////////////////////////
+// @brief: This class represents a reader of the scene files: the input file,
+//		   the static models, particle generators and obstacles. Each line
+//		   is a key followed by values, separated by spaces, tabs or commas
+//		   (color 0.125, 0.698, 0.667). Blank lines and lines starting with
+//		   '#' are skipped. Objects are listed as blocks: a line "start",
+//		   lines of keys, and a line "end".
+//		   The file is mapped and every token is a view into the mapping, so
+//		   reading a line allocates nothing. Errors name the file and line
+//		   and are thrown as ConfigError, so a scene read again while
+//		   running can keep the old one.
+#ifndef CONFIGREADER_H
+#define CONFIGREADER_H
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <stdexcept>
+#include "MappedFile.h"
+#include "glm/glm.hpp"
+
+using namespace std;
+
+// Most tokens on a line, key included
+#define CONFIG_MAX_TOKENS 32
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Error in a scene file, naming the file and line
+struct ConfigError : runtime_error {
+	ConfigError(const string& message) : runtime_error(message) {}
+};
+
+class ConfigReader {
+public:
+	ConfigReader(string _file);
+	ConfigReader(const ConfigReader&) = delete;
+	ConfigReader& operator=(const ConfigReader&) = delete;
+
+	bool nextLine();
+	bool nextBlock();
+	string_view getKey() { return tokens[0]; }
+	size_t getNumValues() { return numTokens - 1; }
+	string_view getValue(size_t i);
+	float getFloat(size_t i);
+	int getInt(size_t i);
+	uint64_t getUInt64(size_t i);
+	glm::vec3 getVec3(size_t i);
+	string getString(size_t i);
+	void expectValues(size_t n);
+	[[noreturn]] void error(string message);
+	const string& getFile() { return file; }
+	int getLineNumber() { return lineNumber; }
+
+private:
+	string file;						//< Name of the file, for errors
+	MappedFile input;					//< Contents of the file
+	const char* p;						//< Start of the next line
+	int lineNumber{0};					//< Line number of the current line
+	string_view tokens[CONFIG_MAX_TOKENS];	//< Key and values of the current
+											//< line
+	size_t numTokens{0};				//< Tokens on the current line
+};
+#endif
@@ -0,0 +1,105 @@
+#include "ConfigSchema.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Bind a key to a variable
+// @param key: key, a string literal
+// @param target: variable set to the key's value
+// @return: the schema, to chain calls
+ConfigSchema&
+ConfigSchema::add(string_view key, float& target){
+	return add(key, FloatValue, &target);
+}
+
+ConfigSchema&
+ConfigSchema::add(string_view key, int& target){
+	return add(key, IntValue, &target);
+}
+
+ConfigSchema&
+ConfigSchema::add(string_view key, uint64_t& target){
+	return add(key, UInt64Value, &target);
+}
+
+ConfigSchema&
+ConfigSchema::add(string_view key, glm::vec3& target){
+	return add(key, Vec3Value, &target);
+}
+
+ConfigSchema&
+ConfigSchema::add(string_view key, string& target){
+	return add(key, StringValue, &target);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Bind a key to a handler
+// @param key: key, a string literal
+// @param handler: called with the reader on a line of the key
+// @return: the schema, to chain calls
+ConfigSchema&
+ConfigSchema::add(string_view key, function<void(ConfigReader&)> handler){
+	add(key, HandlerValue, nullptr);
+	entries.back().handler = handler;
+	return *this;
+}
+
+ConfigSchema&
+ConfigSchema::add(string_view key, ValueType type, void* target){
+	entries.push_back({key, type, target, nullptr});
+	return *this;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Store the values of the reader's current line where its key is
+//		   bound
+// @param reader: reader on a line
+void
+ConfigSchema::bind(ConfigReader& reader){
+	string_view key = reader.getKey();
+	for(Entry& entry : entries){
+		if(entry.key != key)
+			continue;
+		switch(entry.type){
+			case FloatValue:
+				reader.expectValues(1);
+				*(float*)entry.target = reader.getFloat(0);
+				break;
+			case IntValue:
+				reader.expectValues(1);
+				*(int*)entry.target = reader.getInt(0);
+				break;
+			case UInt64Value:
+				reader.expectValues(1);
+				*(uint64_t*)entry.target = reader.getUInt64(0);
+				break;
+			case Vec3Value:
+				reader.expectValues(3);
+				*(glm::vec3*)entry.target = reader.getVec3(0);
+				break;
+			case StringValue:
+				reader.expectValues(1);
+				((string*)entry.target)->assign(reader.getValue(0));
+				break;
+			case HandlerValue:
+				entry.handler(reader);
+				break;
+		}
+		return;
+	}
+	reader.error("unknown key '" + string(key) + "'");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Bind every line up to the one holding only "end"
+// @param reader: reader on the line opening the block
+void
+ConfigSchema::readBlock(ConfigReader& reader){
+	int start = reader.getLineNumber();
+	while(reader.nextLine()){
+		if(reader.getKey() == "end"){
+			reader.expectValues(0);
+			return;
+		}
+		bind(reader);
+	}
+	reader.error("block opened on line " + to_string(start) + " has no end");
+}
@@ -0,0 +1,43 @@
+//////////////////////////////////////////////////////////////////////////////
+// @brief: This class represents the keys a section of a scene file may hold
+//		   and where each one's values go. A plain key is bound to a variable
+//		   and checked for the right number of values; other keys are bound
+//		   to a handler that reads the line itself. A key that is not in the
+//		   schema is an error.
+#ifndef CONFIGSCHEMA_H
+#define CONFIGSCHEMA_H
+#include <vector>
+#include <functional>
+#include "ConfigReader.h"
+
+using namespace std;
+
+class ConfigSchema {
+public:
+	ConfigSchema& add(string_view key, float& target);
+	ConfigSchema& add(string_view key, int& target);
+	ConfigSchema& add(string_view key, uint64_t& target);
+	ConfigSchema& add(string_view key, glm::vec3& target);
+	ConfigSchema& add(string_view key, string& target);
+	ConfigSchema& add(string_view key, function<void(ConfigReader&)> handler);
+	void bind(ConfigReader& reader);
+	void readBlock(ConfigReader& reader);
+
+private:
+	enum ValueType {FloatValue, IntValue, UInt64Value, Vec3Value, StringValue,
+		HandlerValue};
+
+	//////////////////////////////////////////////////////////////////////////
+	// @brief: Key of the schema
+	struct Entry {
+		string_view key;						//< Key, a string literal
+		ValueType type;							//< Type of the target
+		void* target;							//< Variable set, if not a handler
+		function<void(ConfigReader&)> handler;	//< Reads the line, if a handler
+	};
+
+	vector<Entry> entries;		//< Keys in the order added
+
+	ConfigSchema& add(string_view key, ValueType type, void* target);
+};
+#endif
@@ -0,0 +1,93 @@
+#include "FileWatcher.h"
+#include <algorithm>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(LINUX)
+#include <sys/inotify.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Constructor, watches no file
+FileWatcher::FileWatcher(){
+#if defined(LINUX)
+	inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Destructor, stops watching
+FileWatcher::~FileWatcher(){
+#if defined(LINUX)
+	if(inotifyFd >= 0)
+		close(inotifyFd);
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Start watching a file. Watching a file twice does nothing.
+// @param file: path of the file
+void
+FileWatcher::watch(string file){
+	if(find(files.begin(), files.end(), file) != files.end())
+		return;
+	files.push_back(file);
+	mtimes.push_back(modificationTime(file));
+#if defined(LINUX)
+	if(inotifyFd < 0)
+		return;
+	size_t slash = file.find_last_of('/');
+	string directory = slash == string::npos ? "." : file.substr(0, slash + 1);
+	string name = slash == string::npos ? file : file.substr(slash + 1);
+	// A file is complete once closed after writing, or renamed into place
+	int wd = inotify_add_watch(inotifyFd, directory.c_str(),
+		IN_CLOSE_WRITE | IN_MOVED_TO);
+	if(wd >= 0)
+		names[wd].insert(name);
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Whether a watched file was saved since the last call
+bool
+FileWatcher::changed(){
+	bool saved = false;
+#if defined(LINUX)
+	if(inotifyFd >= 0){
+		alignas(inotify_event) char events[4096];
+		ssize_t length;
+		while((length = read(inotifyFd, events, sizeof(events))) > 0){
+			for(char* p = events; p < events + length;){
+				inotify_event* event = (inotify_event*)p;
+				auto directory = names.find(event->wd);
+				if(event->len > 0 && directory != names.end() &&
+					directory->second.count(event->name))
+					saved = true;
+				p += sizeof(inotify_event) + event->len;
+			}
+		}
+		return saved;
+	}
+#endif
+	for(size_t i = 0; i < files.size(); i++){
+		int64_t mtime = modificationTime(files[i]);
+		if(mtime != mtimes[i]){
+			mtimes[i] = mtime;
+			saved = true;
+		}
+	}
+	return saved;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Modification time of a file in ns, 0 if it does not exist
+int64_t
+FileWatcher::modificationTime(const string& file){
+	struct stat info;
+	if(stat(file.c_str(), &info) != 0)
+		return 0;
+#if defined(OSX)
+	return info.st_mtimespec.tv_sec*1000000000ll + info.st_mtimespec.tv_nsec;
+#else
+	return info.st_mtim.tv_sec*1000000000ll + info.st_mtim.tv_nsec;
+#endif
+}
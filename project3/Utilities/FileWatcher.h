@@ -0,0 +1,40 @@
+//////////////////////////////////////////////////////////////////////////////
+// @brief: This class represents a watch on a set of files, to notice when
+//		   one is saved. On Linux, the directories of the files are watched
+//		   with inotify, which also sees editors that save by writing a new
+//		   file and renaming it over the old one; elsewhere the modification
+//		   times of the files are compared. Checking never blocks.
+#ifndef FILEWATCHER_H
+#define FILEWATCHER_H
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
+
+using namespace std;
+
+class FileWatcher {
+public:
+	FileWatcher();
+	~FileWatcher();
+	FileWatcher(const FileWatcher&) = delete;
+	FileWatcher& operator=(const FileWatcher&) = delete;
+
+	void watch(string file);
+	bool changed();
+
+private:
+	vector<string> files;				//< Watched files
+	vector<int64_t> mtimes;				//< Modification time of each file
+										//< when last checked, in ns
+#if defined(LINUX)
+	int inotifyFd{-1};					//< inotify instance, -1 if none
+	unordered_map<int, unordered_set<string>> names;	//< Names of the watched
+														//< files in each watched
+														//< directory
+#endif
+
+	static int64_t modificationTime(const string& file);
+};
+#endif
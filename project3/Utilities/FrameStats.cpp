@@ -0,0 +1,110 @@
+#include "FrameStats.h"
+#include <cstdio>
+#include <algorithm>
+
+static const char* seriesNames[NumFrameSeries] = {"sim", "draw", "idle", "frame"};
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Constructor
+// @param _windowSize: number of recent frames averaged over
+// @param _reportInterval: seconds of frames between reports due, 0 to only
+//		  report on request
+FrameStats::FrameStats(int _windowSize, float _reportInterval){
+	windowSize = max(_windowSize, 1);
+	reportInterval = _reportInterval;
+	reset();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Forget every sample
+void
+FrameStats::reset(){
+	for(auto& s : series){
+		s.histogram.assign(HISTOGRAM_BINS, 0);
+		s.window.assign(windowSize, 0.f);
+		s.count = 0;
+		s.max = 0.f;
+	}
+	sinceReport = 0.f;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Record one sample of a series
+// @param which: series of the sample
+// @param seconds: duration measured
+void
+FrameStats::record(FrameSeries which, float seconds){
+	Series& s = series[which];
+	int bin = (int)(seconds*1000.f/HISTOGRAM_BIN_MS);
+	s.histogram[min(max(bin, 0), HISTOGRAM_BINS - 1)]++;
+	s.window[s.count % windowSize] = seconds;
+	s.count++;
+	s.max = max(s.max, seconds);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Close a frame, after its FrameTime sample was recorded
+// @return: true once every report interval, when a report is due
+bool
+FrameStats::endFrame(){
+	const Series& frame = series[FrameTime];
+	if(frame.count > 0)
+		sinceReport += frame.window[(frame.count - 1) % windowSize];
+	if(reportInterval <= 0 || sinceReport < reportInterval)
+		return false;
+	sinceReport = 0.f;
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Duration below which the given fraction of samples fall, to the
+//		   resolution of a bin
+// @param s: series
+// @param p: fraction, in [0, 1]
+// @return: the percentile in seconds
+float
+FrameStats::percentile(const Series& s, float p){
+	if(s.count == 0)
+		return 0.f;
+	int rank = min((int)(p*s.count), s.count - 1);
+	int seen = 0;
+	for(int bin = 0; bin < HISTOGRAM_BINS - 1; bin++){
+		seen += s.histogram[bin];
+		if(seen > rank)
+			return min((bin + 1)*HISTOGRAM_BIN_MS/1000.f, s.max);
+	}
+	return s.max;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Mean of the samples in the window
+float
+FrameStats::windowMean(const Series& s){
+	int n = min(s.count, windowSize);
+	if(n == 0)
+		return 0.f;
+	float sum = 0.f;
+	for(int i = 0; i < n; i++)
+		sum += s.window[i];
+	return sum/n;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Print the frame rate and, per series, the window mean and the
+//		   percentiles over the whole run, in ms
+void
+FrameStats::print(){
+	const Series& frame = series[FrameTime];
+	float meanFrame = windowMean(frame);
+	printf("Frames: %d, FPS %.2f over the last %d frames\n", frame.count,
+		meanFrame > 0 ? 1.f/meanFrame : 0.f, min(frame.count, windowSize));
+	printf("%-6s %10s %8s %8s %8s %8s\n", "ms", "recent", "p50", "p90",
+		"p99", "max");
+	for(int i = 0; i < NumFrameSeries; i++){
+		const Series& s = series[i];
+		printf("%-6s %10.3f %8.2f %8.2f %8.2f %8.2f\n", seriesNames[i],
+			windowMean(s)*1000.f, percentile(s, 0.5f)*1000.f,
+			percentile(s, 0.9f)*1000.f, percentile(s, 0.99f)*1000.f,
+			s.max*1000.f);
+	}
+}
@@ -0,0 +1,46 @@
+//////////////////////////////////////////////////////////////////////////////
+// @brief: This class represents a collector of frame-time statistics.
+//		   Each series (simulation, drawing, idle delay, whole frame) keeps a
+//		   fixed-size histogram over the whole run, for percentiles, and a
+//		   rolling window of the most recent frames, for the current average.
+//		   Recording a sample is a couple of array writes; nothing is printed
+//		   until a report is asked for.
+#ifndef FRAMESTATS_H
+#define FRAMESTATS_H
+#include <vector>
+
+using namespace std;
+
+// Histogram bins are HISTOGRAM_BIN_MS wide, the last bin holds the rest
+#define HISTOGRAM_BINS 1000
+#define HISTOGRAM_BIN_MS 0.1f
+
+enum FrameSeries {SimTime, DrawTime, IdleTime, FrameTime, NumFrameSeries};
+
+class FrameStats {
+public:
+	FrameStats(int windowSize, float reportInterval);
+	void record(FrameSeries series, float seconds);
+	bool endFrame();
+	void print();
+	void reset();
+
+private:
+	//////////////////////////////////////////////////////////////////////////
+	// @brief: Samples of one series
+	struct Series {
+		vector<int> histogram;		//< Number of samples per bin
+		vector<float> window;		//< Most recent samples, in seconds
+		int count{0};				//< Number of samples recorded
+		float max{0.f};				//< Longest sample, in seconds
+	};
+
+	Series series[NumFrameSeries];	//< One per FrameSeries
+	int windowSize;					//< Number of samples in a window
+	float reportInterval;			//< Seconds between reports, 0 for none
+	float sinceReport{0.f};			//< Frame time since the last report
+
+	float percentile(const Series& s, float p);
+	float windowMean(const Series& s);
+};
+#endif
@@ -0,0 +1,35 @@
+//////////////////////////////////////////////////////////////////////////////
+// @brief: OpenGL/GLUT headers of the platform. Only the window (main.cpp)
+//		   and the drawing code (the *Draw.cpp files) include this, so the
+//		   simulation builds and links without GL.
+#ifndef GL_H
+#define GL_H
+
+#if   defined(OSX)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+#include <GLUT/glut.h>
+#pragma clang diagnostic pop
+#elif defined(LINUX)
+// Buffer objects and other post-1.1 entry points are exported by libGL
+#define GL_GLEXT_PROTOTYPES
+#include <GL/glut.h>
+#endif
+#include <cstdio>
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Whether the current context has buffer objects (OpenGL 1.5)
+inline bool
+glHasBufferObjects(){
+	static int supported = -1;
+	if(supported < 0){
+		int major = 0, minor = 0;
+		const char* version = (const char*)glGetString(GL_VERSION);
+		if(version != nullptr)
+			sscanf(version, "%d.%d", &major, &minor);
+		supported = major > 1 || (major == 1 && minor >= 5);
+	}
+	return supported;
+}
+
+#endif
@@ -0,0 +1,41 @@
+#include "MappedFile.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Constructor, maps the whole file
+// @param path: file to map, isOpen() tells whether it succeeded
+MappedFile::MappedFile(string path){
+	int fd = open(path.c_str(), O_RDONLY);
+	if(fd < 0)
+		return;
+	struct stat info;
+	if(fstat(fd, &info) == 0 && S_ISREG(info.st_mode)){
+		length = info.st_size;
+		// An empty file cannot be mapped, but is a valid empty range
+		if(length == 0)
+			opened = true;
+		else{
+			void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+			if(mapping != MAP_FAILED){
+				data = (const char*)mapping;
+				opened = true;
+				// Scanned front to back once
+				posix_madvise(mapping, length, POSIX_MADV_SEQUENTIAL);
+			}
+			else
+				length = 0;
+		}
+	}
+	// The mapping stays valid after the descriptor is closed
+	close(fd);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Destructor, unmaps the file
+MappedFile::~MappedFile(){
+	if(data != nullptr)
+		munmap((void*)data, length);
+}
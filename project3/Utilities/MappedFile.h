@@ -0,0 +1,29 @@
+//////////////////////////////////////////////////////////////////////////////
+// @brief: This class represents a file mapped read-only into memory, so it
+//		   can be scanned in place without reading it into buffers. The
+//		   mapping lives as long as the object.
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+#include <string>
+#include <cstddef>
+
+using namespace std;
+
+class MappedFile {
+public:
+	MappedFile(string path);
+	~MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool isOpen() { return opened; }
+	const char* begin() { return data; }
+	const char* end() { return data + length; }
+	size_t size() { return length; }
+
+private:
+	const char* data{nullptr};	//< Start of the mapping, null if empty
+	size_t length{0};			//< Size of the file in bytes
+	bool opened{false};			//< Whether the file could be mapped
+};
+#endif
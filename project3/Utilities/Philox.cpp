@@ -0,0 +1,223 @@
+#include "Philox.h"
+#include <cmath>
+
+#if defined(__SSE2__)
+#define PHILOX_SSE2
+#include <emmintrin.h>
+#endif
+
+// Philox4x32 multipliers and Weyl key increments
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+#define PHILOX_ROUNDS 10
+// Words converted per pass of the batch samplers
+#define PHILOX_BATCH 64
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Constructor
+// @param seed: key of the generator
+// @param stream, substream: address of the stream, e.g. frame and generator
+Philox::Philox(uint64_t seed, uint32_t _stream, uint32_t substream){
+	key[0] = (uint32_t)seed;
+	key[1] = (uint32_t)(seed >> 32);
+	stream[0] = _stream;
+	stream[1] = substream;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Compute one block of 4 words
+// @param index: position of the block in the stream
+// @param out: the 4 words of the block
+void
+Philox::generate(uint64_t index, uint32_t* out){
+	uint32_t c[4] = {(uint32_t)index, (uint32_t)(index >> 32), stream[0], stream[1]};
+	uint32_t k[2] = {key[0], key[1]};
+	for(int r = 0; r < PHILOX_ROUNDS; r++){
+		uint64_t p0 = (uint64_t)PHILOX_M0*c[0];
+		uint64_t p1 = (uint64_t)PHILOX_M1*c[2];
+		uint32_t next[4] = {(uint32_t)(p1 >> 32) ^ c[1] ^ k[0], (uint32_t)p1,
+			(uint32_t)(p0 >> 32) ^ c[3] ^ k[1], (uint32_t)p0};
+		for(int w = 0; w < 4; w++)
+			c[w] = next[w];
+		k[0] += PHILOX_W0;
+		k[1] += PHILOX_W1;
+	}
+	for(int w = 0; w < 4; w++)
+		out[w] = c[w];
+}
+
+#ifdef PHILOX_SSE2
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Low and high halves of the 4 products a*m of 32-bit lanes
+static inline void
+mulHiLo(__m128i a, __m128i m, __m128i& hi, __m128i& lo){
+	// Products of lanes 0, 2 and of lanes 1, 3 as 64-bit lanes
+	__m128i even = _mm_mul_epu32(a, m);
+	__m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), m);
+	// [lo0 lo2 hi0 hi2] and [lo1 lo3 hi1 hi3]
+	even = _mm_shuffle_epi32(even, _MM_SHUFFLE(3,1,2,0));
+	odd = _mm_shuffle_epi32(odd, _MM_SHUFFLE(3,1,2,0));
+	lo = _mm_unpacklo_epi32(even, odd);
+	hi = _mm_unpackhi_epi32(even, odd);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Compute 4 consecutive blocks, one block per lane, and store their
+//		   16 words in stream order
+// @param key, stream: key and fixed counter half of the stream
+// @param index: position of the first block in the stream
+// @param out: the 16 words of the blocks
+static void
+generate4(const uint32_t* key, const uint32_t* stream, uint64_t index,
+	uint32_t* out){
+	__m128i c0 = _mm_setr_epi32((uint32_t)index, (uint32_t)(index + 1),
+		(uint32_t)(index + 2), (uint32_t)(index + 3));
+	__m128i c1 = _mm_setr_epi32((uint32_t)(index >> 32), (uint32_t)((index + 1) >> 32),
+		(uint32_t)((index + 2) >> 32), (uint32_t)((index + 3) >> 32));
+	__m128i c2 = _mm_set1_epi32(stream[0]);
+	__m128i c3 = _mm_set1_epi32(stream[1]);
+	const __m128i m0 = _mm_set1_epi32(PHILOX_M0);
+	const __m128i m1 = _mm_set1_epi32(PHILOX_M1);
+	uint32_t k0 = key[0], k1 = key[1];
+	for(int r = 0; r < PHILOX_ROUNDS; r++){
+		__m128i hi0, lo0, hi1, lo1;
+		mulHiLo(c0, m0, hi0, lo0);
+		mulHiLo(c2, m1, hi1, lo1);
+		c0 = _mm_xor_si128(_mm_xor_si128(hi1, c1), _mm_set1_epi32(k0));
+		c1 = lo1;
+		c2 = _mm_xor_si128(_mm_xor_si128(hi0, c3), _mm_set1_epi32(k1));
+		c3 = lo0;
+		k0 += PHILOX_W0;
+		k1 += PHILOX_W1;
+	}
+	// Lanes hold blocks, registers hold words: transpose to stream order
+	__m128i t0 = _mm_unpacklo_epi32(c0, c1);
+	__m128i t1 = _mm_unpacklo_epi32(c2, c3);
+	__m128i t2 = _mm_unpackhi_epi32(c0, c1);
+	__m128i t3 = _mm_unpackhi_epi32(c2, c3);
+	_mm_storeu_si128((__m128i*)(out), _mm_unpacklo_epi64(t0, t1));
+	_mm_storeu_si128((__m128i*)(out + 4), _mm_unpackhi_epi64(t0, t1));
+	_mm_storeu_si128((__m128i*)(out + 8), _mm_unpacklo_epi64(t2, t3));
+	_mm_storeu_si128((__m128i*)(out + 12), _mm_unpackhi_epi64(t2, t3));
+}
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Next word of the stream
+uint32_t
+Philox::next(){
+	uint64_t index = position/4;
+	if(index != blockIndex){
+		generate(index, block);
+		blockIndex = index;
+	}
+	return block[position++ % 4];
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Next n words of the stream, the same words n calls to next() give
+// @param out: array of n words
+// @param n: number of words
+void
+Philox::fill(uint32_t* out, size_t n){
+	size_t i = 0;
+	while(i < n && position % 4 != 0)
+		out[i++] = next();
+#ifdef PHILOX_SSE2
+	for(; i + 16 <= n; i += 16){
+		generate4(key, stream, position/4, out + i);
+		position += 16;
+	}
+#endif
+	while(i < n)
+		out[i++] = next();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Map a word to a float in [0, 1) with 24 random bits
+static inline float
+toUnit(uint32_t word){
+	return (word >> 8)*(1.f/16777216.f);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Map a word to an integer in [lo, hi]
+static inline int
+toRange(uint32_t word, int lo, int hi){
+	if(hi <= lo)
+		return lo;
+	uint64_t range = (uint64_t)((int64_t)hi - lo) + 1;
+	return (int)(lo + (int64_t)((word*range) >> 32));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Uniformly distributed float in [lo, hi)
+float
+Philox::uniform(float lo, float hi){
+	return lo + toUnit(next())*(hi - lo);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Uniformly distributed integer in [lo, hi]
+int
+Philox::uniformInt(int lo, int hi){
+	return toRange(next(), lo, hi);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Fill an array with uniformly distributed floats in [lo, hi)
+// @param out: array of n floats
+// @param n: number of floats
+void
+Philox::uniform(float* out, size_t n, float lo, float hi){
+	uint32_t words[PHILOX_BATCH];
+	for(size_t i = 0; i < n; i += PHILOX_BATCH){
+		size_t count = n - i < PHILOX_BATCH ? n - i : PHILOX_BATCH;
+		fill(words, count);
+		for(size_t k = 0; k < count; k++)
+			out[i + k] = lo + toUnit(words[k])*(hi - lo);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Fill an array with uniformly distributed integers in [lo, hi]
+// @param out: array of n integers
+// @param n: number of integers
+void
+Philox::uniformInt(int* out, size_t n, int lo, int hi){
+	uint32_t words[PHILOX_BATCH];
+	for(size_t i = 0; i < n; i += PHILOX_BATCH){
+		size_t count = n - i < PHILOX_BATCH ? n - i : PHILOX_BATCH;
+		fill(words, count);
+		for(size_t k = 0; k < count; k++)
+			out[i + k] = toRange(words[k], lo, hi);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Fill an array with normally distributed floats, with the
+//		   Box-Muller transform turning each pair of words into two floats
+// @param out: array of n floats
+// @param n: number of floats
+// @param mean, sd: mean and standard deviation of the distribution
+void
+Philox::normal(float* out, size_t n, float mean, float sd){
+	const float twoPi = 6.28318530718f;
+	uint32_t words[PHILOX_BATCH];
+	for(size_t i = 0; i < n; i += PHILOX_BATCH){
+		size_t count = n - i < PHILOX_BATCH ? n - i : PHILOX_BATCH;
+		size_t numPairs = (count + 1)/2;
+		fill(words, 2*numPairs);
+		for(size_t p = 0; p < numPairs; p++){
+			// Shift the first sample to (0, 1] so its log is finite
+			float u1 = ((words[2*p] >> 8) + 1)*(1.f/16777216.f);
+			float u2 = toUnit(words[2*p + 1]);
+			float r = sd*sqrtf(-2.f*logf(u1));
+			out[i + 2*p] = mean + r*cosf(twoPi*u2);
+			if(2*p + 1 < count)
+				out[i + 2*p + 1] = mean + r*sinf(twoPi*u2);
+		}
+	}
+}
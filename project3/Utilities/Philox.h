@@ -0,0 +1,38 @@
+//////////////////////////////////////////////////////////////////////////////
+// @brief: This class represents a stream of random numbers from the
+//		   Philox4x32-10 counter-based generator. Every block of 4 random words
+//		   is a pure function of a 64-bit key and a 128-bit counter, so a
+//		   stream costs nothing to create, any number of independent streams
+//		   can be drawn from in parallel, and a given (key, counter) always
+//		   yields the same numbers. Streams are addressed by two 32-bit words
+//		   (e.g. a frame and a generator id); the other half of the counter
+//		   walks through the stream. Batches of numbers are generated 4
+//		   blocks at a time with SSE2.
+#ifndef PHILOX_H
+#define PHILOX_H
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+class Philox {
+public:
+	Philox(uint64_t seed, uint32_t stream, uint32_t substream);
+	uint32_t next();
+	float uniform(float lo, float hi);
+	int uniformInt(int lo, int hi);
+	void uniform(float* out, size_t n, float lo, float hi);
+	void uniformInt(int* out, size_t n, int lo, int hi);
+	void normal(float* out, size_t n, float mean, float sd);
+
+private:
+	uint32_t key[2];		//< Key, the seed of the stream
+	uint32_t stream[2];		//< Fixed half of the counter
+	uint64_t position{0};	//< Index of the next word in the stream
+	uint32_t block[4];		//< Last block generated
+	uint64_t blockIndex{~0ull};	//< Counter of the block in block
+
+	void generate(uint64_t index, uint32_t* out);
+	void fill(uint32_t* out, size_t n);
+};
+#endif
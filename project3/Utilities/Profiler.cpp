@@ -0,0 +1,139 @@
+#include "Profiler.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <algorithm>
+
+bool Profiler::enabled = false;
+vector<Profiler::Event> Profiler::events;
+atomic<size_t> Profiler::numRecorded{0};
+string Profiler::traceFile;
+
+// Times are measured from the start of the program
+static const chrono::steady_clock::time_point origin = chrono::steady_clock::now();
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Start recording events. The trace and the summary are written
+//		   when the program exits.
+// @param _traceFile: file to write the Chrome trace to
+// @param capacity: number of most recent events kept
+void
+Profiler::enable(string _traceFile, size_t capacity){
+	if(enabled)
+		return;
+	traceFile = _traceFile;
+	events.resize(max(capacity, (size_t)1));
+	enabled = true;
+	atexit(dump);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Current time in ns since the start of the program
+int64_t
+Profiler::now(){
+	return chrono::duration_cast<chrono::nanoseconds>(
+		chrono::steady_clock::now() - origin).count();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Index of the calling thread, assigned on its first event
+int
+Profiler::threadIndex(){
+	static atomic<int> numThreads{0};
+	thread_local int index = numThreads++;
+	return index;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Record an event, overwriting the oldest one once the buffer is
+//		   full. Safe to call from any thread.
+// @param name: phase, must outlive the profiler (a string literal)
+// @param generator: index of the generator, -1 for none
+// @param start, end: times returned by now()
+void
+Profiler::record(const char* name, int generator, int64_t start, int64_t end){
+	size_t slot = numRecorded++ % events.size();
+	events[slot] = {name, generator, threadIndex(), start, end};
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Events still in the buffer, oldest first
+vector<Profiler::Event>
+Profiler::snapshot(){
+	size_t total = numRecorded;
+	size_t count = min(total, events.size());
+	vector<Event> kept;
+	kept.reserve(count);
+	for(size_t i = total - count; i < total; i++)
+		kept.push_back(events[i % events.size()]);
+	return kept;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Write the buffered events as Chrome trace_event JSON
+// @param traceFile: name of the file to write
+void
+Profiler::writeTrace(string traceFile){
+	ofstream out(traceFile);
+	if(!out.is_open()){
+		cerr << "Error: Unable to open file " << traceFile << endl;
+		return;
+	}
+	vector<Event> kept = snapshot();
+	out << "{\"traceEvents\":[\n";
+	char line[256];
+	for(size_t i = 0; i < kept.size(); i++){
+		const Event& e = kept[i];
+		// Complete events, times in microseconds
+		snprintf(line, sizeof(line), "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,"
+			"\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"generator\":%d}}%s\n",
+			e.name, e.thread, e.start/1000.0, (e.end - e.start)/1000.0,
+			e.generator, i + 1 < kept.size() ? "," : "");
+		out << line;
+	}
+	out << "],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Print the count, min, median, p99 and total duration of every
+//		   phase, per generator
+void
+Profiler::printSummary(){
+	vector<Event> kept = snapshot();
+	map<pair<string, int>, vector<int64_t>> phases;
+	for(auto& e : kept)
+		phases[make_pair(string(e.name), e.generator)].push_back(e.end - e.start);
+
+	if(numRecorded > events.size())
+		printf("Profile of the last %zu of %zu events\n", kept.size(),
+			(size_t)numRecorded);
+	printf("%-20s %4s %8s %10s %10s %10s %10s\n", "phase", "gen", "count",
+		"min ms", "median ms", "p99 ms", "total ms");
+	for(auto& phase : phases){
+		vector<int64_t>& d = phase.second;
+		sort(d.begin(), d.end());
+		int64_t total = 0;
+		for(int64_t t : d)
+			total += t;
+		size_t p99 = min(d.size() - 1, d.size()*99/100);
+		char gen[16] = "-";
+		if(phase.first.second >= 0)
+			snprintf(gen, sizeof(gen), "%d", phase.first.second);
+		printf("%-20s %4s %8zu %10.4f %10.4f %10.4f %10.2f\n",
+			phase.first.first.c_str(), gen, d.size(), d.front()/1e6,
+			d[d.size()/2]/1e6, d[p99]/1e6, total/1e6);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Write the trace and print the summary, run at exit
+void
+Profiler::dump(){
+	enabled = false;
+	writeTrace(traceFile);
+	printSummary();
+	printf("Profile trace written to %s\n", traceFile.c_str());
+}
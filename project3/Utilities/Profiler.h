@@ -0,0 +1,72 @@
+//////////////////////////////////////////////////////////////////////////////
+// @brief: This class represents a frame profiler. Scoped timers
+//		   (ProfileScope) placed around the phases of a frame record one event
+//		   each, tagged with the phase name, the generator it worked for and
+//		   the thread it ran on, into a fixed-size ring buffer that keeps the
+//		   most recent events. On exit the buffer is written out as a Chrome
+//		   trace_event JSON file (open it in chrome://tracing or Perfetto) and
+//		   a min/median/p99 summary per phase is printed.
+//		   While the profiler is disabled a timer costs one branch on a flag.
+#ifndef PROFILER_H
+#define PROFILER_H
+#include <vector>
+#include <string>
+#include <atomic>
+#include <cstdint>
+
+using namespace std;
+
+class Profiler {
+public:
+	static void enable(string traceFile, size_t capacity = 1 << 18);
+	static bool isEnabled() { return enabled; }
+	static int64_t now();
+	static void record(const char* name, int generator, int64_t start,
+		int64_t end);
+	static void writeTrace(string traceFile);
+	static void printSummary();
+
+private:
+	//////////////////////////////////////////////////////////////////////////
+	// @brief: One timed run of a phase
+	struct Event {
+		const char* name;	//< Phase, a string literal
+		int generator;		//< Index of the generator, -1 for none
+		int thread;			//< Index of the thread that ran it
+		int64_t start;		//< Start time, ns since the profiler started
+		int64_t end;		//< End time, ns since the profiler started
+	};
+
+	static bool enabled;				//< Whether timers record events
+	static vector<Event> events;		//< Ring buffer of events
+	static atomic<size_t> numRecorded;	//< Events recorded so far
+	static string traceFile;			//< File the trace is written to
+
+	static vector<Event> snapshot();
+	static void dump();
+	static int threadIndex();
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: This class represents a timer recording the time spent in its
+//		   scope as one profiler event
+class ProfileScope {
+public:
+	ProfileScope(const char* _name, int _generator = -1) {
+		if(Profiler::isEnabled()){
+			name = _name;
+			generator = _generator;
+			start = Profiler::now();
+		}
+	}
+	~ProfileScope() {
+		if(start >= 0)
+			Profiler::record(name, generator, start, Profiler::now());
+	}
+
+private:
+	const char* name;		//< Phase timed
+	int generator;			//< Generator the phase works for
+	int64_t start{-1};		//< Start time, -1 while the profiler is disabled
+};
+#endif
@@ -0,0 +1,52 @@
+#include "StreamBuffer.h"
+#include <algorithm>
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Constructor
+// @param numBuffers: number of buffers cycled through, 2 or 3 keeps the
+//		  driver from stalling on a buffer still in use
+StreamBuffer::StreamBuffer(int numBuffers){
+	buffers.resize(max(numBuffers, 1));
+	capacities.assign(buffers.size(), 0);
+	glGenBuffers(buffers.size(), buffers.data());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Destructor
+StreamBuffer::~StreamBuffer(){
+	glDeleteBuffers(buffers.size(), buffers.data());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Bind the next buffer of the ring to GL_ARRAY_BUFFER, orphan its
+//		   old storage and map it for writing
+// @param bytes: number of bytes to be written
+// @return: pointer to write the vertices to, nullptr if the driver could not
+//			map the buffer (it is left unbound)
+void*
+StreamBuffer::map(size_t bytes){
+	current = (current + 1) % buffers.size();
+	glBindBuffer(GL_ARRAY_BUFFER, buffers[current]);
+	// Grow geometrically so a slowly growing particle count does not
+	// reallocate every frame
+	size_t& capacity = capacities[current];
+	if(bytes > capacity)
+		capacity = max(bytes, capacity*2);
+	glBufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+	void* data = glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
+	if(data == nullptr)
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	return data;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Unmap the buffer returned by map, which stays bound for drawing
+// @return: false if its contents were lost while mapped (the buffer is then
+//			unbound and must be written again)
+bool
+StreamBuffer::unmap(){
+	if(glUnmapBuffer(GL_ARRAY_BUFFER) == GL_TRUE)
+		return true;
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	return false;
+}
@@ -0,0 +1,28 @@
+//////////////////////////////////////////////////////////////////////////////
+// @brief: This class represents a vertex buffer whose contents are rewritten
+//		   every frame. It cycles through a small ring of GL buffer objects
+//		   and orphans each one before mapping it, so the CPU never waits on
+//		   the GPU still reading last frame's vertices. Only drawing code
+//		   includes this, a GL context with buffer objects must be current
+//		   for every call (see glHasBufferObjects).
+#ifndef STREAMBUFFER_H
+#define STREAMBUFFER_H
+#include <vector>
+#include <cstddef>
+#include "GL.h"
+
+using namespace std;
+
+class StreamBuffer {
+public:
+	StreamBuffer(int numBuffers = 3);
+	~StreamBuffer();
+	void* map(size_t bytes);
+	bool unmap();
+
+private:
+	vector<GLuint> buffers;		//< Ring of buffer objects
+	vector<size_t> capacities;	//< Allocated size of each buffer, in bytes
+	int current{-1};			//< Buffer last mapped
+};
+#endif
@@ -0,0 +1,133 @@
+#include "ThreadPool.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Constructor. Start the worker threads.
+// @param _numThreads: total number of threads running a loop, including the
+//		  thread that calls parallelFor. 0 uses one thread per core.
+ThreadPool::ThreadPool(int _numThreads){
+	numThreads = _numThreads;
+	if(numThreads <= 0)
+		numThreads = max(1u, thread::hardware_concurrency());
+	for(int i = 0; i < numThreads; i++)
+		queues.push_back(unique_ptr<WorkQueue>(new WorkQueue()));
+	for(int i = 1; i < numThreads; i++)
+		workers.push_back(thread(&ThreadPool::workerLoop, this, i));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Destructor. Stop and join the worker threads.
+ThreadPool::~ThreadPool(){
+	{
+		lock_guard<mutex> guard(jobLock);
+		stopping = true;
+	}
+	jobReady.notify_all();
+	for(auto& worker : workers)
+		worker.join();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Run body over [begin, end) split into chunks of at most grainSize
+//		   elements, and return once every chunk has finished. Chunks may run
+//		   in any order and on any thread, so body must only touch data of
+//		   its own chunk.
+// @param begin: first index of the range
+// @param end: one past the last index of the range
+// @param grainSize: maximum number of indices per chunk
+// @param body: called as body(chunkBegin, chunkEnd)
+void
+ThreadPool::parallelFor(size_t begin, size_t end, size_t grainSize,
+	const function<void(size_t, size_t)>& _body){
+	if(begin >= end)
+		return;
+	if(grainSize == 0)
+		grainSize = 1;
+	// Nothing to share, run on the calling thread
+	if(numThreads == 1 || end - begin <= grainSize){
+		_body(begin, end);
+		return;
+	}
+
+	// Deal contiguous runs of chunks to each queue so a thread that does not
+	// need to steal walks memory in order. The body is published before any
+	// chunk, since a worker still draining the last loop may pick one up.
+	size_t numChunks = (end - begin + grainSize - 1)/grainSize;
+	size_t perQueue = (numChunks + numThreads - 1)/numThreads;
+	body = &_body;
+	pending = numChunks;
+	for(size_t c = 0; c < numChunks; c++){
+		size_t chunkBegin = begin + c*grainSize;
+		size_t chunkEnd = min(end, chunkBegin + grainSize);
+		WorkQueue& queue = *queues[c/perQueue];
+		lock_guard<mutex> guard(queue.lock);
+		queue.chunks.push_back(make_pair(chunkBegin, chunkEnd));
+	}
+	{
+		lock_guard<mutex> guard(jobLock);
+		generation++;
+	}
+	jobReady.notify_all();
+
+	// The calling thread works too, then waits for chunks other threads
+	// are still running
+	while(runChunk(0));
+	unique_lock<mutex> guard(jobLock);
+	jobDone.wait(guard, [this]{ return pending == 0; });
+	body = nullptr;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Run one chunk, taken from the thread's own queue or stolen from
+//		   another thread's queue
+// @param id: index of the thread
+// @return: false if every queue was empty
+bool
+ThreadPool::runChunk(int id){
+	pair<size_t, size_t> chunk;
+	bool found = false;
+	{
+		WorkQueue& own = *queues[id];
+		lock_guard<mutex> guard(own.lock);
+		if(!own.chunks.empty()){
+			chunk = own.chunks.front();
+			own.chunks.pop_front();
+			found = true;
+		}
+	}
+	for(int i = 1; i < numThreads && !found; i++){
+		WorkQueue& victim = *queues[(id + i) % numThreads];
+		lock_guard<mutex> guard(victim.lock);
+		if(!victim.chunks.empty()){
+			chunk = victim.chunks.back();
+			victim.chunks.pop_back();
+			found = true;
+		}
+	}
+	if(!found)
+		return false;
+
+	(*body)(chunk.first, chunk.second);
+	if(--pending == 0){
+		lock_guard<mutex> guard(jobLock);
+		jobDone.notify_all();
+	}
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// @brief: Main loop of a worker thread: wait for a loop, help run it, repeat
+// @param id: index of the thread
+void
+ThreadPool::workerLoop(int id){
+	size_t seen = 0;
+	while(true){
+		{
+			unique_lock<mutex> guard(jobLock);
+			jobReady.wait(guard, [&]{ return stopping || generation != seen; });
+			if(stopping)
+				return;
+			seen = generation;
+		}
+		while(runChunk(id));
+	}
+}
@@ -0,0 +1,51 @@
+//////////////////////////////////////////////////////////////////////////////
+// @brief: This class represents a fixed pool of worker threads that runs
+//		   parallel-for loops. A loop's range is cut into chunks which are
+//		   dealt out to per-thread queues; a thread works through its own
+//		   queue front to back and, once it runs dry, steals chunks from the
+//		   back of the other queues so no core sits idle at the end of a loop.
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+using namespace std;
+
+class ThreadPool {
+public:
+	ThreadPool(int numThreads);
+	~ThreadPool();
+	void parallelFor(size_t begin, size_t end, size_t grainSize,
+		const function<void(size_t, size_t)>& body);
+	int getNumThreads() { return numThreads; }
+
+private:
+	//////////////////////////////////////////////////////////////////////////
+	// @brief: Chunks of the current loop waiting to be run by one thread
+	struct WorkQueue {
+		mutex lock;
+		deque<pair<size_t, size_t>> chunks;
+	};
+
+	int numThreads;							//< Workers plus the calling thread
+	vector<thread> workers;					//< Worker threads
+	vector<unique_ptr<WorkQueue>> queues;	//< One queue per thread, the
+											//< calling thread owns queue 0
+	const function<void(size_t, size_t)>* body{nullptr};  //< Current loop body
+	atomic<size_t> pending{0};				//< Chunks not finished yet
+	mutex jobLock;							//< Guards generation and stopping
+	condition_variable jobReady;			//< Wakes workers for a new loop
+	condition_variable jobDone;				//< Wakes the caller when done
+	size_t generation{0};					//< Incremented for every loop
+	bool stopping{false};					//< Set when the pool shuts down
+
+	void workerLoop(int id);
+	bool runChunk(int id);
+};
+#endif
@@ -0,0 +1,590 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Contains main function to run the microbenchmarks
+///
+/// Times the hot paths of the simulation on synthetic inputs: integration,
+/// emission per generator type, obstacle collision checks, attractor forces,
+/// whole simulation steps and OBJ parsing (shipped models and generated
+/// large meshes). Each case runs with a set of parameters; the median and
+/// minimum time per iteration are printed as a table and, with --json, saved
+/// as JSON so runs on different commits can be compared. The heap held by
+/// the mesh of each shipped model is printed after the timings.
+///
+/// Usage: spiderling-bench [--filter <substring>] [--repeat <n>] [--quick]
+///                         [--json <file>]
+///
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+
+// STL
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <dirent.h>
+#include "Simulation/Simulator.h"
+#include "Simulation/Integrator.h"
+#include "Models/MeshCache.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Benchmark harness
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Timing of one case with one set of parameters
+struct Result {
+  string name;                          //< Name of the case
+  vector<pair<string, double>> params;  //< Parameters of the case
+  double items;                         //< Items processed per iteration
+  int iterations;                       //< Iterations per repeat
+  vector<double> samples;               //< Seconds per iteration, per repeat
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Heap held by the mesh of one model
+struct MeshMemory {
+  string name;                          //< Name of the model
+  size_t faces;                         //< Faces of the OBJ
+  size_t triangles;                     //< Triangles drawn
+  size_t bytes;                         //< Heap held by the mesh
+};
+
+// Options
+string g_filter;
+int g_repeats{5};
+bool g_quick{false};
+// Seconds each repeat runs for, at least
+const double g_minRepeatTime{0.05};
+vector<Result> g_results;
+vector<MeshMemory> g_meshMemory;
+// Directory of the generated input files
+string g_tmpDir;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Seconds since an arbitrary point
+double
+now() {
+  using namespace std::chrono;
+  return duration_cast<duration<double>>(
+    steady_clock::now().time_since_epoch()).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Full name of a case, e.g. emit/type=Fire/particles=1000
+string
+caseName(const string& name, const vector<pair<string, double>>& params,
+  const vector<string>& labels) {
+  string full = name;
+  for(size_t i = 0; i < params.size(); i++){
+    char value[64];
+    snprintf(value, sizeof(value), "%g", params[i].second);
+    full += "/" + params[i].first + "=" +
+      (i < labels.size() && labels[i] != "" ? labels[i] : string(value));
+  }
+  return full;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Time a case. The body is run once to warm up and calibrate the
+///        number of iterations, then g_repeats times that many iterations.
+/// @param name Name of the case
+/// @param params Parameters of the case
+/// @param items Number of items (particles, faces, ...) one iteration handles
+/// @param body One iteration
+/// @param labels Optional text values of the parameters, for the name
+void
+runCase(const string& name, vector<pair<string, double>> params, double items,
+  const function<void()>& body, vector<string> labels = vector<string>()) {
+  Result result;
+  result.name = caseName(name, params, labels);
+  if(g_filter != "" && result.name.find(g_filter) == string::npos)
+    return;
+  result.params = params;
+  result.items = items;
+
+  double start = now();
+  body();
+  double once = max(now() - start, 1e-9);
+  result.iterations = max(1, (int)(g_minRepeatTime/once));
+  for(int r = 0; r < g_repeats; r++){
+    start = now();
+    for(int i = 0; i < result.iterations; i++)
+      body();
+    result.samples.push_back((now() - start)/result.iterations);
+  }
+
+  vector<double> sorted = result.samples;
+  sort(sorted.begin(), sorted.end());
+  double median = sorted[sorted.size()/2];
+  printf("%-50s %12.4f %12.4f %14.0f\n", result.name.c_str(), median*1e3,
+    sorted.front()*1e3, items/median);
+  fflush(stdout);
+  g_results.push_back(result);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Save the results as JSON
+/// @param file Name of the file
+void
+writeJson(const string& file) {
+  FILE* out = fopen(file.c_str(), "w");
+  if(!out){
+    cerr << "Error: Unable to open file " << file << endl;
+    exit(1);
+  }
+  fprintf(out, "{\n  \"integrator\": \"%s\",\n  \"repeats\": %d,\n"
+    "  \"results\": [\n", getIntegratorName(), g_repeats);
+  for(size_t i = 0; i < g_results.size(); i++){
+    const Result& r = g_results[i];
+    vector<double> sorted = r.samples;
+    sort(sorted.begin(), sorted.end());
+    double median = sorted[sorted.size()/2];
+    fprintf(out, "    {\"name\": \"%s\", \"params\": {", r.name.c_str());
+    for(size_t p = 0; p < r.params.size(); p++)
+      fprintf(out, "%s\"%s\": %g", p ? ", " : "", r.params[p].first.c_str(),
+        r.params[p].second);
+    fprintf(out, "}, \"iterations\": %d, \"median_s\": %.9g, \"min_s\": %.9g, "
+      "\"items\": %g, \"items_per_s\": %.6g, \"samples_s\": [", r.iterations,
+      median, sorted.front(), r.items, r.items/median);
+    for(size_t s = 0; s < r.samples.size(); s++)
+      fprintf(out, "%s%.9g", s ? ", " : "", r.samples[s]);
+    fprintf(out, "]}%s\n", i + 1 < g_results.size() ? "," : "");
+  }
+  fprintf(out, "  ],\n  \"mesh_memory\": [\n");
+  for(size_t i = 0; i < g_meshMemory.size(); i++){
+    const MeshMemory& m = g_meshMemory[i];
+    fprintf(out, "    {\"name\": \"%s\", \"faces\": %zu, \"triangles\": %zu, "
+      "\"bytes\": %zu}%s\n", m.name.c_str(), m.faces, m.triangles, m.bytes,
+      i + 1 < g_meshMemory.size() ? "," : "");
+  }
+  fprintf(out, "  ]\n}\n");
+  fclose(out);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Write a generated input file into the temporary directory
+/// @param name Name of the file
+/// @param contents Contents of the file
+/// @return Path of the file
+string
+writeInput(const string& name, const string& contents) {
+  string path = g_tmpDir + "/" + name;
+  ofstream out(path);
+  out << contents;
+  return path;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Text of a particle generator spawning a fixed number of particles
+///        every frame
+/// @param type Generator type
+/// @param perFrame Particles spawned per frame
+/// @param life Longevity of the particles, in frames
+string
+generatorText(const string& type, int perFrame, int life) {
+  string shape;
+  if(type == "Point")
+    shape = "type Point position 0 20 0";
+  else if(type == "Line")
+    shape = "type Line point1 -10 20 0 point2 10 20 0 normal 0.2 -0.5 0.3";
+  else
+    shape = "type " + type + " center 0 2 0 radius 3 normal 0 1 0";
+  return "start\n" + shape + "\n"
+    "distribution uniform\n"
+    "maxParticles " + to_string(perFrame*(life + 1)) + "\n"
+    "minimumLife " + to_string(life) + "\n"
+    "maximumLife " + to_string(life) + "\n"
+    "minNumGenerated " + to_string(perFrame) + "\n"
+    "maxNumGenerated " + to_string(perFrame) + "\n"
+    "timeIntervalGeneration 0\n"
+    "elasticity 0.9\nfriction 0.1\nminVel 2\nmaxVel 5\n"
+    "gravity 0 -9.8 0\nsd 0.5\nforceStrength 0.5\n"
+    "color 1 0 0\ncolor 1 1 0\ncolor 1 1 1\n"
+    "alphaStart 1.0\nalphaEnd 0.2\nsize 2.0\nmass 1.0\n"
+    "end\n";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Text of n horizontal obstacles stacked on top of each other
+string
+obstaclesText(int n) {
+  string text;
+  for(int i = 0; i < n; i++){
+    string y = to_string(i*2);
+    text += "start\nPoint1 45 " + y + " -45\nPoint2 45 " + y + " 45\n"
+      "Point3 -45 " + y + " 45\nPoint4 -45 " + y + " -45\n"
+      "Normal 0 1 0\nstyle invisible\nend\n";
+  }
+  return text;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Text of a grid mesh of about the given number of triangles, with
+///        positions, texture coordinates and normals
+string
+gridObjText(int numTriangles) {
+  int side = max(2, (int)sqrt(numTriangles/2.0) + 1);
+  string text;
+  text.reserve((size_t)numTriangles*64);
+  char line[128];
+  for(int j = 0; j < side; j++)
+    for(int i = 0; i < side; i++){
+      snprintf(line, sizeof(line), "v %f %f %f\n", (float)i,
+        sinf(i*0.1f)*cosf(j*0.1f), (float)j);
+      text += line;
+    }
+  for(int j = 0; j < side; j++)
+    for(int i = 0; i < side; i++){
+      snprintf(line, sizeof(line), "vt %f %f\n", (float)i/side, (float)j/side);
+      text += line;
+    }
+  text += "vn 0.000000 1.000000 0.000000\n";
+  for(int j = 0; j + 1 < side; j++)
+    for(int i = 0; i + 1 < side; i++){
+      int a = j*side + i + 1, b = a + 1, c = a + side, d = c + 1;
+      snprintf(line, sizeof(line), "f %d/%d/1 %d/%d/1 %d/%d/1\n", a, a, c, c,
+        b, b);
+      text += line;
+      snprintf(line, sizeof(line), "f %d/%d/1 %d/%d/1 %d/%d/1\n", b, b, c, c,
+        d, d);
+      text += line;
+    }
+  return text;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Particle positions and velocities scattered over the scene
+void
+randomParticles(size_t n, vector<glm::vec3>& pos, vector<glm::vec3>& vel) {
+  Philox random(7, 0, 0);
+  vector<float> values(6*n);
+  random.uniform(&values[0], 3*n, -40.f, 40.f);
+  random.uniform(&values[3*n], 3*n, -5.f, 5.f);
+  pos.resize(n);
+  vel.resize(n);
+  for(size_t i = 0; i < n; i++){
+    pos[i] = glm::vec3(values[3*i], values[3*i+1] + 40.f, values[3*i+2]);
+    vel[i] = glm::vec3(values[3*n+3*i], values[3*n+3*i+1], values[3*n+3*i+2]);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Cases
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Euler step of n particles, vector kernel and scalar per-particle
+///        update
+void
+benchIntegrate() {
+  vector<int> counts = g_quick ? vector<int>{10000, 100000} :
+    vector<int>{10000, 100000, 1000000};
+  for(int n : counts){
+    vector<glm::vec3> pos, vel, acc(n), force(n, glm::vec3(0, -9.8f, 0));
+    randomParticles(n, pos, vel);
+    runCase("integrate", {{"particles", (double)n}}, n, [&]{
+      integrateParticles(pos.data(), vel.data(), acc.data(), force.data(), n,
+        1.f, 5.f, 0.001f);
+    });
+
+    ParticlePool pool;
+    ParticleClass particleClass{};
+    particleClass.mass = 1.f;
+    particleClass.size = 1.f;
+    particleClass.maxVel = 5.f;
+    pool.setClass(make_shared<const ParticleClass>(particleClass));
+    pool.reserve(n, 1);
+    for(int i = 0; i < n; i++)
+      pool.add(pos[i], vel[i], 1);
+    runCase("update.scalar", {{"particles", (double)n}}, n, [&]{
+      for(int i = 0; i < n; i++)
+        pool.update(i, force[i], pool.getState(i), 0.001f);
+    });
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Emission of each generator type. Particles live one frame, so
+///        every iteration spawns and retires the same number of particles.
+void
+benchEmit() {
+  vector<string> types = {"Point", "Line", "Circle", "Beam", "Fire"};
+  vector<int> counts = g_quick ? vector<int>{1000} : vector<int>{100, 1000, 10000};
+  for(size_t t = 0; t < types.size(); t++)
+    for(int n : counts){
+      string file = writeInput("emit.txt", generatorText(types[t], n, 1));
+      vector<GeneratorDescription> descriptions;
+      ParticleGenerator::parseInGenerators(file, descriptions);
+      ParticleGenerator generator(descriptions[0], 0.01f);
+      generator.seedRandom(42, 0);
+      ParticlePool& particles = generator.getParticles();
+      runCase("emit", {{"type", (double)t}, {"particles", (double)n}}, n, [&]{
+        particles.advanceFrame();
+        generator.generateParticles();
+        particles.retireExpired();
+      }, {types[t], ""});
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Collision checks of particle moves against a list of obstacles,
+///        stopping at the first obstacle crossed like the simulator does
+void
+benchCollision() {
+  const int n = g_quick ? 10000 : 100000;
+  vector<glm::vec3> pos, vel;
+  randomParticles(n, pos, vel);
+  for(int numObstacles : {1, 8, 64}){
+    vector<ObstacleDescription> descriptions;
+    Obstacle::parseInObstacles(writeInput("obstacles.txt",
+      obstaclesText(numObstacles)), descriptions);
+    vector<shared_ptr<Obstacle>> obstacles;
+    for(auto& description : descriptions)
+      obstacles.push_back(make_shared<Obstacle>(description));
+    int hits = 0;
+    runCase("collision", {{"obstacles", (double)numObstacles}, {"particles", (double)n}}, n, [&]{
+      for(int i = 0; i < n; i++){
+        State oldState, newState;
+        oldState.pos = pos[i];
+        newState.pos = pos[i] + vel[i]*0.5f;
+        for(auto& obstacle : obstacles)
+          if(!obstacle->checkCollision(oldState, newState).none){
+            hits++;
+            break;
+          }
+      }
+    });
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Attractor forces on batches of particles, with bounding box culling
+void
+benchForces() {
+  const int n = g_quick ? 10000 : 100000;
+  const int batch = 2048;
+  vector<glm::vec3> pos, vel, forces(n);
+  randomParticles(n, pos, vel);
+  // Batches of nearby particles, as the pools have after a few frames
+  sort(pos.begin(), pos.end(), [](const glm::vec3& a, const glm::vec3& b){
+    return a.x < b.x; });
+  for(int numAttractors : {1, 4, 16}){
+    vector<shared_ptr<Attractor>> attractors;
+    for(int a = 0; a < numAttractors; a++){
+      float x = -40.f + 80.f*(a + 0.5f)/numAttractors;
+      attractors.push_back(make_shared<Attractor>(glm::vec3(x, 40, 0), 15.f, 0.3f));
+      attractors.back()->toggleActivate();
+    }
+    runCase("forces", {{"attractors", (double)numAttractors}, {"particles", (double)n}}, n, [&]{
+      for(int begin = 0; begin < n; begin += batch){
+        int count = min(batch, n - begin);
+        glm::vec3 boundsMin = pos[begin], boundsMax = pos[begin];
+        for(int k = 1; k < count; k++){
+          boundsMin = glm::min(boundsMin, pos[begin + k]);
+          boundsMax = glm::max(boundsMax, pos[begin + k]);
+        }
+        for(auto& attractor : attractors)
+          attractor->accumulateForces(&pos[begin], count, boundsMin,
+            boundsMax, &forces[begin]);
+      }
+    });
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Whole simulation steps of a synthetic scene: a fire and a line
+///        generator over a floor, with attractors and a repeller
+void
+benchStep() {
+  vector<int> counts = g_quick ? vector<int>{500} : vector<int>{500, 2000};
+  for(int perFrame : counts)
+    for(int threads : {1, 0}){
+      string generators = writeInput("stepGenerators.txt",
+        generatorText("Fire", perFrame, 60) + "\n" +
+        generatorText("Line", perFrame, 60));
+      string obstacles = writeInput("stepObstacles.txt", obstaclesText(1));
+      string scene = writeInput("step.txt",
+        "TimeStep 0.05\nThreads " + to_string(threads) + "\nSeed 42\n"
+        "ParticleGenerators " + generators + "\n"
+        "Obstacles " + obstacles + "\n"
+        "Attractor 0 10 0 20.0 0.3\nAttractor 10 5 0 10.0 0.3\n"
+        "Repeller 0 2 5 10.0 0.3\n");
+      Simulator simulator(scene);
+      for(auto& attractor : simulator.getAttractors())
+        attractor->toggleActivate();
+      for(auto& repeller : simulator.getRepellers())
+        repeller->toggleActivate();
+      // Fill the pools up to their steady state
+      for(int i = 0; i < 60; i++)
+        simulator.update();
+      double particles = 0;
+      for(auto& generator : simulator.getGenerators())
+        particles += generator->getParticles().size();
+      runCase("step", {{"perFrame", (double)perFrame}, {"threads", (double)threads}}, particles,
+        [&]{ simulator.update(); });
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief OBJ parsing of the shipped models and of generated grids
+void
+benchParse() {
+  MeshCache::setDirectory("off");
+  vector<string> shipped = {"robot", "lake", "monster"};
+  for(size_t m = 0; m < shipped.size(); m++){
+    string file = "Models/OBJS/" + shipped[m] + ".obj";
+    if(!ifstream(file).good()){
+      cerr << "Skipping " << file << ": not found" << endl;
+      continue;
+    }
+    size_t faces = 0;
+    {
+      ifstream in(file);
+      string line;
+      while(getline(in, line))
+        faces += line.compare(0, 2, "f ") == 0;
+    }
+    runCase("parse", {{"mesh", (double)m}, {"faces", (double)faces}}, faces, [&]{
+      Model model(file, shipped[m], glm::vec3(0), glm::vec3(0, 0, 1),
+        glm::vec3(1), glm::vec3(1));
+    }, {shipped[m], ""});
+  }
+  vector<int> sizes = g_quick ? vector<int>{100000} :
+    vector<int>{100000, 1000000};
+  for(int numTriangles : sizes){
+    string file = writeInput("grid.obj", gridObjText(numTriangles));
+    int side = max(2, (int)sqrt(numTriangles/2.0) + 1);
+    double faces = 2.0*(side - 1)*(side - 1);
+    runCase("parse", {{"mesh", -1.0}, {"faces", faces}}, faces, [&]{
+      Model model(file, "grid", glm::vec3(0), glm::vec3(0, 0, 1),
+        glm::vec3(1), glm::vec3(1));
+    }, {"grid", ""});
+    remove(file.c_str());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Loading the shipped models and a generated grid from their mesh
+///        caches, written by a first cold load
+void
+benchLoad() {
+  string cacheDir = g_tmpDir + "/meshcache";
+  MeshCache::setDirectory(cacheDir);
+  vector<string> files, names;
+  for(string name : {"robot", "lake", "monster"})
+    if(ifstream("Models/OBJS/" + name + ".obj").good()){
+      files.push_back("Models/OBJS/" + name + ".obj");
+      names.push_back(name);
+    }
+  int numTriangles = g_quick ? 100000 : 1000000;
+  string grid = writeInput("grid.obj", gridObjText(numTriangles));
+  files.push_back(grid);
+  names.push_back("grid");
+  for(size_t m = 0; m < files.size(); m++){
+    Model cold(files[m], names[m], glm::vec3(0), glm::vec3(0, 0, 1),
+      glm::vec3(1), glm::vec3(1));
+    double faces = cold.getMesh().getNumFaces();
+    double mesh = names[m] == "grid" ? -1.0 : (double)m;
+    runCase("load", {{"mesh", mesh}, {"faces", faces}}, faces, [&]{
+      Model model(files[m], names[m], glm::vec3(0), glm::vec3(0, 0, 1),
+        glm::vec3(1), glm::vec3(1));
+    }, {names[m], ""});
+  }
+  remove(grid.c_str());
+  MeshCache::setDirectory("off");
+
+  if(DIR* dir = opendir(cacheDir.c_str())){
+    while(dirent* entry = readdir(dir))
+      if(entry->d_name[0] != '.')
+        remove((cacheDir + "/" + entry->d_name).c_str());
+    closedir(dir);
+  }
+  rmdir(cacheDir.c_str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Heap held by the mesh of each shipped model, parsed without the
+///        mesh cache so every array owns its elements
+void
+benchMeshMemory() {
+  MeshCache::setDirectory("off");
+  for(string name : {"robot", "lake", "monster"}){
+    string file = "Models/OBJS/" + name + ".obj";
+    if(!ifstream(file).good() || (g_filter != "" &&
+      ("memory/mesh=" + name).find(g_filter) == string::npos))
+      continue;
+    Model model(file, name, glm::vec3(0), glm::vec3(0, 0, 1), glm::vec3(1),
+      glm::vec3(1));
+    const Mesh& mesh = model.getMesh();
+    g_meshMemory.push_back({name, mesh.getNumFaces(), mesh.indices.size()/3,
+      mesh.getMemoryUsage()});
+  }
+  if(g_meshMemory.empty())
+    return;
+  printf("\n%-20s %12s %12s %12s %14s\n", "mesh", "faces", "triangles", "MB",
+    "bytes/triangle");
+  for(const MeshMemory& m : g_meshMemory)
+    printf("%-20s %12zu %12zu %12.2f %14.1f\n", m.name.c_str(), m.faces,
+      m.triangles, m.bytes/1e6, (double)m.bytes/max<size_t>(1, m.triangles));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Main
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief main
+/// @param _argc Count of command line arguments
+/// @param _argv Command line arguments
+/// @return Application success status
+int
+main(int _argc, char** _argv) {
+  string jsonFile;
+  for(int i = 1; i < _argc; i++){
+    string arg = _argv[i];
+    if(arg == "--filter" && i + 1 < _argc)
+      g_filter = _argv[++i];
+    else if(arg == "--repeat" && i + 1 < _argc)
+      g_repeats = max(1, atoi(_argv[++i]));
+    else if(arg == "--json" && i + 1 < _argc)
+      jsonFile = _argv[++i];
+    else if(arg == "--quick")
+      g_quick = true;
+    else {
+      cerr << "Usage: " << _argv[0] << " [--filter <substring>] "
+        "[--repeat <n>] [--quick] [--json <file>]" << endl;
+      exit(0);
+    }
+  }
+
+  char tmpDir[] = "/tmp/spiderling-bench-XXXXXX";
+  if(!mkdtemp(tmpDir)){
+    cerr << "Error: Unable to create a temporary directory" << endl;
+    exit(1);
+  }
+  g_tmpDir = tmpDir;
+
+  printf("Integrator: %s\n", getIntegratorName());
+  printf("%-50s %12s %12s %14s\n", "case", "median ms", "min ms", "items/s");
+  benchIntegrate();
+  benchEmit();
+  benchCollision();
+  benchForces();
+  benchStep();
+  benchParse();
+  benchLoad();
+  benchMeshMemory();
+
+  for(const char* name : {"emit.txt", "obstacles.txt", "stepGenerators.txt",
+    "stepObstacles.txt", "step.txt"})
+    remove((g_tmpDir + "/" + name).c_str());
+  rmdir(g_tmpDir.c_str());
+  if(jsonFile != "")
+    writeJson(jsonFile);
+  return 0;
+}
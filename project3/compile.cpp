@@ -0,0 +1,52 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Contains main function to compile a scene into a scene bundle
+///
+/// Reads a scene's input file and every file it names, loads the meshes of
+/// its static models, and writes them all to one binary scene bundle. The
+/// simulator and the headless runner take the bundle in place of the input
+/// file and start from it without parsing any text.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+
+// STL
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include "Simulation/SceneBundle.h"
+#include "Models/MeshCache.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Main
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief main
+/// @param _argc Count of command line arguments
+/// @param _argv Command line arguments: scene file, bundle file
+/// @return Application success status
+int
+main(int _argc, char** _argv) {
+  if (_argc < 3 ){
+    cerr << "Usage: " << _argv[0] << " [input file for scene] [bundle file]"
+      << endl;
+    exit(0);
+  }
+
+  SceneDescription scene;
+  try{
+    scene.read(_argv[1]);
+  } catch(const ConfigError& e){
+    cerr << "Error: " << e.what() << endl;
+    exit(1);
+  }
+  if(!scene.meshCache.empty())
+    MeshCache::setDirectory(scene.meshCache);
+  SceneBundle::save(_argv[2], scene);
+  printf("Compiled %s into %s: %zu generators, %zu obstacles, %zu models\n",
+    _argv[1], _argv[2], scene.generators.size(), scene.obstacles.size(),
+    scene.models.size());
+  return 0;
+}
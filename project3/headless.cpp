@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Contains main function to run a scene without a window
+///
+/// Loads a scene, runs a fixed number of simulation steps as fast as possible
+/// and reports the throughput. Links no GL, so it runs on machines without a
+/// display or GPU.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+
+// STL
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include "Simulation/Simulator.h"
+#include "Simulation/Integrator.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Main
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief main
+/// @param _argc Count of command line arguments
+/// @param _argv Command line arguments: scene file, number of steps
+/// @return Application success status
+int
+main(int _argc, char** _argv) {
+  using namespace std::chrono;
+
+  if (_argc < 2 ){
+    cerr << "Usage: " << _argv[0] << " [input file for scene] [steps]" << endl;
+    exit(0);
+  }
+  int steps = _argc > 2 ? atoi(_argv[2]) : 1000;
+
+  high_resolution_clock::time_point start = high_resolution_clock::now();
+  Simulator simulator(_argv[1]);
+  simulator.waitForModels();
+  high_resolution_clock::time_point loaded = high_resolution_clock::now();
+
+  // Particles alive at each step, summed, is the number of particle updates
+  long long particleSteps = 0;
+  for(int i = 0; i < steps; i++){
+    simulator.update();
+    for(auto& generator : simulator.getGenerators())
+      particleSteps += generator->getParticles().size();
+  }
+  high_resolution_clock::time_point done = high_resolution_clock::now();
+
+  size_t numParticles = 0;
+  for(auto& generator : simulator.getGenerators())
+    numParticles += generator->getParticles().size();
+  float loadTime = duration_cast<duration<float>>(loaded - start).count();
+  float runTime = duration_cast<duration<float>>(done - loaded).count();
+  printf("Scene: %s\n", _argv[1]);
+  printf("Seed: %llu Integrator: %s\n",
+    (unsigned long long)simulator.getSeed(), getIntegratorName());
+  printf("Load: %.3fs\n", loadTime);
+  printf("Steps: %d in %.3fs (%.1f steps/s)\n", steps, runTime,
+    runTime > 0 ? steps/runTime : 0.f);
+  printf("Particles: %zu at the end, %.0f particles/s\n", numParticles,
+    runTime > 0 ? particleSteps/runTime : 0.f);
+  return 0;
+}
@@ -24,8 +24,10 @@
 #include <vector>
 #include <unordered_map>
 #include "Simulation/Simulator.h"
+#include "Utilities/GL.h"
+#include "Utilities/FrameStats.h"
 
-// OPEN GL Includes linked from "Model.h"
+// OPEN GL Includes linked from "Utilities/GL.h"
 #ifndef __MAC__
 #define __MAC__ 1
 #endif
@@ -48,11 +50,14 @@ static int submenuModel_id;
 
 // Frame rate
 const unsigned int FPS = 60;
-float g_frameRate{0.f};
 std::chrono::high_resolution_clock::time_point g_frameTime{
   std::chrono::high_resolution_clock::now()};
 float g_delay{0.f};
-float g_framesPerSecond{0.f};
+float g_simTime{0.f};
+float g_drawTime{0.f};
+
+// Frame statistics, averaged over the last 4 s and reported every 10 s
+FrameStats g_frameStats(4*FPS, 10.f);
 
 ////////////////////////////////////////////////////////////////////////////////
 // Functions
@@ -63,6 +68,9 @@ void
 initialize() {
   glEnable(GL_COLOR_MATERIAL);
   glEnable(GL_DEPTH_TEST);
+  std::cout << "Particles drawn "
+    << (ParticleGenerator::isStreamDrawing() ? "from vertex buffers"
+      : "in immediate mode") << std::endl;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -106,12 +114,25 @@ resize(GLint _w, GLint _h) {
 /// Note, this is rudametary and fragile.
 void
 timer(int _v) {
+  using namespace std::chrono;
+
   if(g_window != 0) {
     /// Might need to change where to call update
+    // Reloads are kept out of the simulation time, but not out of the slot
+    high_resolution_clock::time_point reloadStart = high_resolution_clock::now();
+    simulator->reloadChangedFiles();
+    high_resolution_clock::time_point start = high_resolution_clock::now();
     simulator->update();
+    g_simTime = duration_cast<duration<float>>(
+      high_resolution_clock::now() - start).count();
+    g_frameStats.record(SimTime, g_simTime);
     glutPostRedisplay();
 
-    g_delay = std::max(0.f, 1.f/FPS - g_frameRate);
+    // Wait for whatever the frame's work leaves of its time slot
+    float reloadTime = duration_cast<duration<float>>(
+      start - reloadStart).count();
+    g_delay = std::max(0.f, 1.f/FPS - reloadTime - g_simTime - g_drawTime);
+    g_frameStats.record(IdleTime, g_delay);
     glutTimerFunc((unsigned int)(1000.f*g_delay), timer, 0);
   }
   else
@@ -142,11 +163,20 @@ void createMenu(void){
     glutAttachMenu(GLUT_RIGHT_BUTTON);
 } 
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Print the frame statistics
+void
+reportFrameStats() {
+  g_frameStats.print();
+  printf("Retired last frame: %d\n", simulator->getRetiredCount());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief Draw function for single frame
 void
 draw() {
   using namespace std::chrono;
+  high_resolution_clock::time_point start = high_resolution_clock::now();
 
   //////////////////////////////////////////////////////////////////////////////
   // Clear
@@ -180,12 +210,16 @@ draw() {
   glutSwapBuffers();
 
   //////////////////////////////////////////////////////////////////////////////
-  // Record frame time
+  // Record frame time. The time between two draws is the whole frame,
+  // simulation and idle delay included.
   high_resolution_clock::time_point time = high_resolution_clock::now();
-  g_frameRate = duration_cast<duration<float>>(time - g_frameTime).count();
+  g_drawTime = duration_cast<duration<float>>(time - start).count();
+  g_frameStats.record(DrawTime, g_drawTime);
+  g_frameStats.record(FrameTime,
+    duration_cast<duration<float>>(time - g_frameTime).count());
   g_frameTime = time;
-  g_framesPerSecond = 1.f/(g_delay + g_frameRate);
-  printf("FPS: %6.2f\n", g_framesPerSecond);
+  if(g_frameStats.endFrame())
+    reportFrameStats();
 
 }
 
@@ -251,6 +285,16 @@ keyPressed(GLubyte _key, GLint _x, GLint _y) {
         attractor->toggleActivate();
       }
       break;
+    case 'f':
+      reportFrameStats();
+      break;
+    case 'v':
+      // Switch between streamed and immediate mode particle drawing
+      ParticleGenerator::setStreamDrawing(!ParticleGenerator::isStreamDrawing());
+      std::cout << "Particles drawn "
+        << (ParticleGenerator::isStreamDrawing() ? "from vertex buffers"
+          : "in immediate mode") << std::endl;
+      break;
     default:
       std::cout << "Unhandled key: " << (int)(_key) << std::endl;
       break;
@@ -314,6 +358,8 @@ main(int _argc, char** _argv) {
   }
 
   simulator = make_shared<Simulator>(_argv[1]);
+  // Edits to the scene's files apply while running
+  simulator->watchSceneFiles();
 
   //////////////////////////////////////////////////////////////////////////////
   // Initialize GLUT Window